@@ -0,0 +1,18 @@
+-- Bot Reset History Table
+-- This table records every bot reset and level skip. It is written in batches by the module and the
+-- resets of the last ResetBotLevel.ResetCooldown seconds are read back at startup.
+
+DROP TABLE IF EXISTS `bot_reset_history`;
+
+CREATE TABLE `bot_reset_history` (
+  `id` int(10) unsigned NOT NULL AUTO_INCREMENT,
+  `guid` int(10) unsigned NOT NULL COMMENT 'Character GUID of the bot',
+  `from_level` tinyint(3) unsigned NOT NULL COMMENT 'Level before the reset or skip',
+  `to_level` tinyint(3) unsigned NOT NULL COMMENT 'Level after the reset or skip',
+  `skipped` tinyint(1) NOT NULL DEFAULT '0' COMMENT '0 = reset, 1 = level skip',
+  `reason` tinyint(3) unsigned NOT NULL COMMENT 'Hook that made the decision: 0 = login, 1 = level change, 2 = time played check',
+  `reset_time` timestamp NOT NULL DEFAULT CURRENT_TIMESTAMP COMMENT 'Time of the reset or skip',
+  PRIMARY KEY (`id`),
+  KEY `idx_guid_time` (`guid`, `reset_time`),
+  KEY `idx_time` (`reset_time`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COLLATE=utf8mb4_unicode_ci COMMENT='History of bot level resets and skips';
@@ -0,0 +1,9 @@
+-- Bot Reset GM Commands
+-- Help entries for the .botreset commands.
+
+DELETE FROM `command` WHERE `name` IN ('botreset', 'botreset stats', 'botreset stats reset');
+
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('botreset', 2, 'Syntax: .botreset $subcommand\r\nType .botreset to see the list of possible subcommands or .help botreset $subcommand to see info on subcommands.'),
+('botreset stats', 2, 'Syntax: .botreset stats\r\nShows mod-player-bot-reset counters: hook filter results, resets and skips per level and class, the reset queue and Randomize/time check/guild tracker timings.'),
+('botreset stats reset', 3, 'Syntax: .botreset stats reset\r\nResets the mod-player-bot-reset counters shown by .botreset stats.');
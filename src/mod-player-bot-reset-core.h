@@ -0,0 +1,1217 @@
+#ifndef MOD_PLAYER_BOT_RESET_CORE_H
+#define MOD_PLAYER_BOT_RESET_CORE_H
+
+// Decision-path building blocks of mod-player-bot-reset. Nothing in here touches Player, ObjectAccessor,
+// the playerbots managers or the database, so it can be driven by synthetic bots outside a worldserver.
+
+#include "DBCEnums.h"
+#include "Define.h"
+#include "SharedDefines.h"
+#include "Util.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// EXCLUSION MATCHER: ResetBotLevel.ExcludeNames compiled at load time
+// Plain names go into a case-folded hash set, "Prefix*" patterns into a prefix trie and any other
+// pattern using '*' or '?' is kept as a glob. Matching is case insensitive.
+// -----------------------------------------------------------------------------
+class BotNameExclusions
+{
+public:
+    void Clear()
+    {
+        _names.clear();
+        _prefixTrie.assign(1, TrieNode());
+        _globs.clear();
+        _size = 0;
+    }
+
+    void Add(std::string const& pattern)
+    {
+        std::wstring folded;
+        if (!FoldName(pattern, folded) || folded.empty())
+            return;
+
+        std::size_t wildcard = folded.find_first_of(L"*?");
+        if (wildcard == std::wstring::npos)
+        {
+            _names.insert(folded);
+        }
+        else if (wildcard == folded.size() - 1 && folded.back() == L'*')
+        {
+            if (_prefixTrie.empty())
+                _prefixTrie.emplace_back();
+
+            uint32 node = 0;
+            for (std::size_t i = 0; i < wildcard; ++i)
+            {
+                auto itr = _prefixTrie[node].children.find(folded[i]);
+                if (itr == _prefixTrie[node].children.end())
+                {
+                    uint32 child = static_cast<uint32>(_prefixTrie.size());
+                    _prefixTrie[node].children.emplace(folded[i], child);
+                    _prefixTrie.emplace_back();
+                    node = child;
+                }
+                else
+                {
+                    node = itr->second;
+                }
+            }
+            _prefixTrie[node].terminal = true;
+        }
+        else
+        {
+            _globs.push_back(folded);
+        }
+        ++_size;
+    }
+
+    bool Matches(std::string const& name) const
+    {
+        if (_size == 0)
+            return false;
+
+        std::wstring folded;
+        if (!FoldName(name, folded))
+            return false;
+
+        if (_names.count(folded) > 0)
+            return true;
+
+        if (!_prefixTrie.empty())
+        {
+            uint32 node = 0;
+            for (std::size_t i = 0; ; ++i)
+            {
+                if (_prefixTrie[node].terminal)
+                    return true;
+                if (i == folded.size())
+                    break;
+
+                auto itr = _prefixTrie[node].children.find(folded[i]);
+                if (itr == _prefixTrie[node].children.end())
+                    break;
+                node = itr->second;
+            }
+        }
+
+        for (std::wstring const& glob : _globs)
+        {
+            if (GlobMatch(glob, folded))
+                return true;
+        }
+        return false;
+    }
+
+    std::size_t Size() const { return _size; }
+    bool Empty() const { return _size == 0; }
+
+private:
+    struct TrieNode
+    {
+        std::unordered_map<wchar_t, uint32> children;
+        bool terminal = false;
+    };
+
+    static bool FoldName(std::string const& name, std::wstring& folded)
+    {
+        if (!Utf8toWStr(name, folded))
+            return false;
+        wstrToLower(folded);
+        return true;
+    }
+
+    static bool GlobMatch(std::wstring const& pattern, std::wstring const& name)
+    {
+        std::size_t p = 0, n = 0;
+        std::size_t star = std::wstring::npos, mark = 0;
+        while (n < name.size())
+        {
+            if (p < pattern.size() && (pattern[p] == L'?' || pattern[p] == name[n]))
+            {
+                ++p;
+                ++n;
+            }
+            else if (p < pattern.size() && pattern[p] == L'*')
+            {
+                star = p++;
+                mark = n;
+            }
+            else if (star != std::wstring::npos)
+            {
+                p = star + 1;
+                n = ++mark;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        while (p < pattern.size() && pattern[p] == L'*')
+            ++p;
+        return p == pattern.size();
+    }
+
+    std::unordered_set<std::wstring> _names;
+    std::vector<TrieNode> _prefixTrie; // node 0 is the root
+    std::vector<std::wstring> _globs;
+    std::size_t _size = 0;
+};
+
+// -----------------------------------------------------------------------------
+// REAL PLAYER GUILD INDEX
+// Online real players are refcounted per guild from the login/logout and guild membership hooks. Guilds
+// known to have real players, online or not, are kept in the stored set backed by the
+// bot_reset_guild_tracker table: a vector sorted by guild ID holding the last time a real player was
+// seen in the guild. Guilds new to the stored set, or whose row is due for a refresh, are remembered as
+// touched and written by the next flush; a guild that stays online is only rewritten once its row is due.
+// -----------------------------------------------------------------------------
+class RealPlayerGuildIndex
+{
+public:
+    struct StoredGuild
+    {
+        uint32 guildId;
+        uint32 lastSeen;  // unix time a real player was last seen in the guild
+    };
+
+    void AddOnlinePlayer(uint32 playerGuid, uint32 guildId)
+    {
+        RemoveOnlinePlayer(playerGuid);
+        if (guildId == 0)
+            return;
+
+        _onlinePlayerGuild[playerGuid] = guildId;
+        ++_onlineGuildRefs[guildId];
+
+        // The guild is stored right away, its last seen time is set by the next flush
+        auto itr = FindStored(guildId);
+        if (itr == _storedGuilds.end() || itr->guildId != guildId)
+        {
+            _storedGuilds.insert(itr, StoredGuild{ guildId, 0 });
+            _touchedGuilds.insert(guildId);
+        }
+        else if (itr->lastSeen < _refreshBefore)
+        {
+            _touchedGuilds.insert(guildId);
+        }
+    }
+
+    void RemoveOnlinePlayer(uint32 playerGuid)
+    {
+        auto itr = _onlinePlayerGuild.find(playerGuid);
+        if (itr == _onlinePlayerGuild.end())
+            return;
+
+        auto refItr = _onlineGuildRefs.find(itr->second);
+        if (refItr != _onlineGuildRefs.end() && --refItr->second == 0)
+            _onlineGuildRefs.erase(refItr);
+        _onlinePlayerGuild.erase(itr);
+    }
+
+    void RemoveGuild(uint32 guildId)
+    {
+        _onlineGuildRefs.erase(guildId);
+        auto stored = FindStored(guildId);
+        if (stored != _storedGuilds.end() && stored->guildId == guildId)
+            _storedGuilds.erase(stored);
+        _touchedGuilds.erase(guildId);
+        for (auto itr = _onlinePlayerGuild.begin(); itr != _onlinePlayerGuild.end();)
+        {
+            if (itr->second == guildId)
+                itr = _onlinePlayerGuild.erase(itr);
+            else
+                ++itr;
+        }
+    }
+
+    bool HasRealPlayer(uint32 guildId) const
+    {
+        if (guildId == 0)
+            return false;
+
+        // Until the stored set is loaded every guild is treated as protected
+        if (!_storedLoaded)
+            return true;
+
+        // Online real players are tracked by the refcounts, offline ones by the stored set
+        if (_onlineGuildRefs.count(guildId) > 0)
+            return true;
+        auto itr = FindStored(guildId);
+        return itr != _storedGuilds.end() && itr->guildId == guildId;
+    }
+
+    // Merges the rows read from the database into the stored set, guilds touched meanwhile are kept
+    void LoadStoredGuilds(std::vector<StoredGuild> guilds)
+    {
+        MergeStored(std::move(guilds));
+        _storedLoaded = true;
+    }
+
+    // Adds guilds found to contain real characters by a reconciliation query. New ones and the ones due
+    // for a refresh are marked touched, so the next flush writes them out and refreshes their last seen time.
+    void AddReconciledGuilds(std::vector<uint32> const& guildIds)
+    {
+        std::vector<StoredGuild> guilds;
+        guilds.reserve(guildIds.size());
+        for (uint32 guildId : guildIds)
+        {
+            if (guildId == 0)
+                continue;
+
+            auto itr = FindStored(guildId);
+            if (itr == _storedGuilds.end() || itr->guildId != guildId || itr->lastSeen < _refreshBefore)
+                _touchedGuilds.insert(guildId);
+            guilds.push_back(StoredGuild{ guildId, 0 });
+        }
+        MergeStored(std::move(guilds));
+    }
+
+    bool IsStoredLoaded() const { return _storedLoaded; }
+
+    // Stamps the touched guilds, plus the online ones last seen before refreshBefore, with now and appends
+    // their IDs to out. Rows seen since refreshBefore are not rewritten, 0 never refreshes a stored row.
+    void TakeTouchedGuilds(uint32 now, uint32 refreshBefore, std::vector<uint32>& out)
+    {
+        _refreshBefore = refreshBefore;
+        for (auto const& [guildId, refs] : _onlineGuildRefs)
+        {
+            auto itr = FindStored(guildId);
+            if (itr != _storedGuilds.end() && itr->guildId == guildId && itr->lastSeen < refreshBefore)
+                _touchedGuilds.insert(guildId);
+        }
+
+        for (uint32 guildId : _touchedGuilds)
+        {
+            auto itr = FindStored(guildId);
+            if (itr != _storedGuilds.end() && itr->guildId == guildId)
+                itr->lastSeen = now;
+            out.push_back(guildId);
+        }
+        _touchedGuilds.clear();
+    }
+
+    // Removes the stored guilds last seen before the given time and appends their IDs to out
+    void TakeExpiredGuilds(uint32 before, std::vector<uint32>& out)
+    {
+        auto expired = std::remove_if(_storedGuilds.begin(), _storedGuilds.end(), [&](StoredGuild const& guild)
+        {
+            if (guild.lastSeen >= before || _onlineGuildRefs.count(guild.guildId) > 0 || _touchedGuilds.count(guild.guildId) > 0)
+                return false;
+            out.push_back(guild.guildId);
+            return true;
+        });
+        _storedGuilds.erase(expired, _storedGuilds.end());
+    }
+
+    std::size_t GetOnlineGuildCount() const { return _onlineGuildRefs.size(); }
+    std::size_t GetTrackedGuildCount() const { return _storedGuilds.size(); }
+
+private:
+    void MergeStored(std::vector<StoredGuild> guilds)
+    {
+        guilds.insert(guilds.end(), _storedGuilds.begin(), _storedGuilds.end());
+        std::sort(guilds.begin(), guilds.end(), [](StoredGuild const& a, StoredGuild const& b)
+        {
+            return a.guildId != b.guildId ? a.guildId < b.guildId : a.lastSeen > b.lastSeen;
+        });
+        guilds.erase(std::unique(guilds.begin(), guilds.end(), [](StoredGuild const& a, StoredGuild const& b)
+        {
+            return a.guildId == b.guildId;
+        }), guilds.end());
+        guilds.shrink_to_fit();
+        _storedGuilds = std::move(guilds);
+    }
+
+    std::vector<StoredGuild>::iterator FindStored(uint32 guildId)
+    {
+        return std::lower_bound(_storedGuilds.begin(), _storedGuilds.end(), guildId,
+            [](StoredGuild const& guild, uint32 id) { return guild.guildId < id; });
+    }
+
+    std::vector<StoredGuild>::const_iterator FindStored(uint32 guildId) const
+    {
+        return std::lower_bound(_storedGuilds.begin(), _storedGuilds.end(), guildId,
+            [](StoredGuild const& guild, uint32 id) { return guild.guildId < id; });
+    }
+
+    std::unordered_map<uint32, uint32> _onlineGuildRefs;     // guild ID -> online real players in it
+    std::unordered_map<uint32, uint32> _onlinePlayerGuild;   // online real player -> guild it is counted against
+    std::vector<StoredGuild> _storedGuilds;                  // sorted by guild ID
+    std::unordered_set<uint32> _touchedGuilds;
+    uint32 _refreshBefore = 0;                               // rows last seen before this are due for a refresh
+    bool _storedLoaded = false;
+};
+
+// -----------------------------------------------------------------------------
+// RANDOM BOT ROSTER
+// Every random bot character, online or offline, as a compact record in one vector sorted by GUID. It is
+// read from the characters table in ascending chunks at startup and kept current by the hooks after that.
+// -----------------------------------------------------------------------------
+struct RandomBotRecord
+{
+    uint32 guid;
+    uint32 account;
+    uint32 guildId;
+    uint32 levelPlayedTime;  // as of the last login, logout or level change
+    uint32 totalPlayedTime;  // as of the last login, logout or level change
+    uint8 level;
+    uint8 playerClass;
+    bool online;
+};
+
+class RandomBotRoster
+{
+public:
+    // Merges a chunk of rows sorted by GUID. Records the hooks wrote meanwhile are newer and kept.
+    void LoadRecords(std::vector<RandomBotRecord> const& rows)
+    {
+        if (rows.empty())
+            return;
+
+        // Chunks arrive in ascending order, so usually they only extend the roster
+        if (_records.empty() || _records.back().guid < rows.front().guid)
+        {
+            _records.insert(_records.end(), rows.begin(), rows.end());
+            return;
+        }
+
+        std::vector<RandomBotRecord> merged;
+        merged.reserve(_records.size() + rows.size());
+        auto existing = _records.begin();
+        for (RandomBotRecord const& row : rows)
+        {
+            while (existing != _records.end() && existing->guid < row.guid)
+                merged.push_back(*existing++);
+            if (existing == _records.end() || existing->guid != row.guid)
+                merged.push_back(row);
+        }
+        merged.insert(merged.end(), existing, _records.end());
+        _records = std::move(merged);
+    }
+
+    void SetLoaded() { _loaded = true; }
+    bool IsLoaded() const { return _loaded; }
+
+    RandomBotRecord* Find(uint32 guid)
+    {
+        auto itr = LowerBound(guid);
+        return itr != _records.end() && itr->guid == guid ? &*itr : nullptr;
+    }
+
+    RandomBotRecord const* Find(uint32 guid) const
+    {
+        return const_cast<RandomBotRoster*>(this)->Find(guid);
+    }
+
+    // Bots created after startup are inserted in place, which is rare enough to shift the vector
+    RandomBotRecord& Upsert(uint32 guid)
+    {
+        auto itr = LowerBound(guid);
+        if (itr == _records.end() || itr->guid != guid)
+            itr = _records.insert(itr, RandomBotRecord{ guid, 0, 0, 0, 0, 0, 0, false });
+        return *itr;
+    }
+
+    void Remove(uint32 guid)
+    {
+        auto itr = LowerBound(guid);
+        if (itr != _records.end() && itr->guid == guid)
+            _records.erase(itr);
+    }
+
+    void ClearGuild(uint32 guildId)
+    {
+        for (RandomBotRecord& record : _records)
+            if (record.guildId == guildId)
+                record.guildId = 0;
+    }
+
+    std::vector<RandomBotRecord> const& Records() const { return _records; }
+    std::size_t Size() const { return _records.size(); }
+
+private:
+    std::vector<RandomBotRecord>::iterator LowerBound(uint32 guid)
+    {
+        return std::lower_bound(_records.begin(), _records.end(), guid,
+            [](RandomBotRecord const& record, uint32 id) { return record.guid < id; });
+    }
+
+    std::vector<RandomBotRecord> _records;
+    bool _loaded = false;
+};
+
+// -----------------------------------------------------------------------------
+// DEADLINE SCHEDULER
+// Min-heap of (time, bot) pairs. Entries are invalidated lazily: a heap entry only counts while it
+// matches the bot's current deadline, so rescheduling and cancelling are O(log n) / O(1).
+// -----------------------------------------------------------------------------
+class BotDeadlineScheduler
+{
+public:
+    void Schedule(uint32 guid, uint64 at)
+    {
+        _deadlines[guid] = at;
+        _heap.push(Deadline{ at, guid });
+    }
+
+    void Cancel(uint32 guid)
+    {
+        // The heap entry is discarded when it comes up
+        _deadlines.erase(guid);
+    }
+
+    // Pops the next due bot, skipping stale heap entries. Returns false when nothing is due.
+    bool PopDue(uint64 now, uint32& guid)
+    {
+        while (!_heap.empty() && _heap.top().at <= now)
+        {
+            Deadline deadline = _heap.top();
+            _heap.pop();
+
+            auto itr = _deadlines.find(deadline.guid);
+            if (itr == _deadlines.end() || itr->second != deadline.at)
+                continue;
+
+            _deadlines.erase(itr);
+            guid = deadline.guid;
+            return true;
+        }
+        return false;
+    }
+
+    std::size_t Size() const { return _deadlines.size(); }
+
+private:
+    struct Deadline
+    {
+        uint64 at;
+        uint32 guid;
+
+        bool operator>(Deadline const& right) const { return at > right.at; }
+    };
+
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> _heap;
+    std::unordered_map<uint32, uint64> _deadlines;
+};
+
+// -----------------------------------------------------------------------------
+// RESET CHANCE
+// With scaling the chance grows linearly with the level and reaches the configured chance at maxLevel.
+// -----------------------------------------------------------------------------
+inline uint8 ComputeResetChance(uint8 level, uint8 maxLevel, uint8 chancePercent, bool scaled)
+{
+    if (!scaled || maxLevel == 0 || level >= maxLevel)
+        return chancePercent;
+    return static_cast<uint8>(uint32(level) * chancePercent / maxLevel);
+}
+
+// -----------------------------------------------------------------------------
+// LEVEL DISTRIBUTION
+// Online eligible bots per level, kept current by the eligibility cache with one counter update per
+// login, logout or level change. It is written by the world thread only and read from any thread.
+// With a target distribution configured, the reset chance at a level is the share of the bots there that
+// have to leave for the level to hold its target share of the population, and 0 when it holds no more.
+// Levels below the first band are not steered: bots have to level through them to reach the bands.
+// -----------------------------------------------------------------------------
+class LevelHistogram
+{
+public:
+    void Add(uint8 level)
+    {
+        _counts[level].fetch_add(1, std::memory_order_relaxed);
+        _total.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Remove(uint8 level)
+    {
+        _counts[level].fetch_sub(1, std::memory_order_relaxed);
+        _total.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void Move(uint8 fromLevel, uint8 toLevel)
+    {
+        _counts[fromLevel].fetch_sub(1, std::memory_order_relaxed);
+        _counts[toLevel].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint32 Count(uint8 level) const { return _counts[level].load(std::memory_order_relaxed); }
+    uint32 Total() const { return _total.load(std::memory_order_relaxed); }
+    std::array<std::atomic<uint32>, STRONG_MAX_LEVEL + 1> const& Counts() const { return _counts; }
+
+private:
+    std::array<std::atomic<uint32>, STRONG_MAX_LEVEL + 1> _counts{};
+    std::atomic<uint32> _total{ 0 };
+};
+
+struct LevelDistributionTarget
+{
+    std::array<uint32, STRONG_MAX_LEVEL + 1> weight{};  // relative share of the population wanted at each level
+    uint64 totalWeight = 0;
+    uint8 firstLevel = 0;                               // lowest level covered by a band
+
+    bool IsActive() const { return totalWeight > 0; }
+};
+
+inline uint8 ComputeSteeredResetChance(LevelHistogram const& levels, LevelDistributionTarget const& target, uint8 level)
+{
+    uint32 const count = levels.Count(level);
+    if (count == 0 || level < target.firstLevel)
+        return 0;
+
+    uint64 const wanted = uint64(levels.Total()) * target.weight[level] / target.totalWeight;
+    return count > wanted ? static_cast<uint8>((count - wanted) * 100 / count) : 0;
+}
+
+// -----------------------------------------------------------------------------
+// RESET POLICY
+// One side-effect-free decision function shared by the login, level-change and time-check paths. It
+// works on a small POD snapshot of the bot and runs its filters cheapest first: the level rules, then
+// the cached eligibility bits and only then the guild lookup. The level rules, reset targets and chances
+// are compiled into a level x class table when the config is loaded, so that first stage is a single
+// lookup. The chance roll (0-99) is worked out from the snapshot, so the function stays pure and the same
+// snapshot always gets the same decision.
+// -----------------------------------------------------------------------------
+enum BotEligibilityFlags : uint8
+{
+    BOT_ELIGIBILITY_BOT        = 0x01,
+    BOT_ELIGIBILITY_RANDOM_BOT = 0x02,
+    BOT_ELIGIBILITY_EXCLUDED   = 0x04,
+    BOT_ELIGIBILITY_DEBUG_LOG  = 0x08   // picked by the debug log sampling, not used by the policy
+};
+
+enum class BotResetTrigger : uint8
+{
+    Login,
+    LevelChanged,
+    TimeCheck
+};
+
+enum class BotResetVerdict : uint8
+{
+    None,   // nothing to do
+    Reset,  // reset to ResetToLevel
+    Skip,   // skip to SkipToLevel
+    Defer   // look at the bot again after deferSeconds
+};
+
+// Filter stage that decided the verdict, BOT_RESET_FILTER_PASSED when the bot got through all of them
+enum BotResetFilter : uint8
+{
+    BOT_RESET_FILTER_LEVEL,
+    BOT_RESET_FILTER_NOT_BOT,
+    BOT_RESET_FILTER_NOT_RANDOM_BOT,
+    BOT_RESET_FILTER_EXCLUDED,
+    BOT_RESET_FILTER_GUILD,
+    BOT_RESET_FILTER_PASSED,
+    MAX_BOT_RESET_FILTER
+};
+
+struct BotSnapshot
+{
+    uint32 guid;
+    uint32 levelPlayedTime;  // seconds played at the current level
+    uint32 totalPlayedTime;  // seconds played in total, the epoch of the chance roll
+    uint32 guildId;
+    uint8 level;
+    uint8 playerClass;
+    uint8 flags;             // BotEligibilityFlags
+};
+
+struct BotResetDecision
+{
+    BotResetVerdict verdict;
+    BotResetFilter filter;
+    uint32 deferSeconds;
+    uint8 targetLevel;  // level a Reset or Skip sends the bot to
+};
+
+namespace BotResetPolicy
+{
+    // Outcome of the level rules alone, before any eligibility or guild lookup
+    enum LevelRule : uint8
+    {
+        LEVEL_RULE_NONE,
+        LEVEL_RULE_RESET,
+        LEVEL_RULE_SKIP,
+        LEVEL_RULE_ROLL,         // reset if the chance roll passes
+        LEVEL_RULE_WAIT_PLAYED   // at max level, waiting for MinTimePlayed
+    };
+}
+
+// Levels below this cannot be reached by a class, Death Knights start at 55
+inline uint8 GetClassStartLevel(uint8 playerClass)
+{
+    return playerClass == CLASS_DEATH_KNIGHT ? 55 : 1;
+}
+
+// A bot reaching fromLevel is sent to toLevel
+struct BotSkipRange
+{
+    uint8 fromLevel;
+    uint8 toLevel;
+};
+
+// Compiled level rules, chance and target for one level and class
+struct BotResetPolicyEntry
+{
+    std::array<uint8, 3> rule{};  // BotResetPolicy::LevelRule, indexed by BotResetTrigger
+    uint8 chance = 0;             // reset chance in percent for LEVEL_RULE_ROLL
+    uint8 targetLevel = 0;        // level a reset or skip from this level sends the bot to
+};
+
+struct BotResetPolicyConfig
+{
+    // Per-class settings left at this value use the global one
+    static constexpr uint8 USE_DEFAULT = 0xFF;
+
+    uint8 maxLevel = 80;
+    uint8 resetToLevel = 1;
+    uint8 chancePercent = 100;
+    bool scaledChance = false;
+    bool restrictByPlayedTime = false;
+    bool ignoreGuildsWithRealPlayers = false;
+    uint32 minTimePlayed = 86400;
+    uint32 retryInterval = 864;  // seconds before a deferred bot that failed its roll is looked at again
+    uint32 rollSeed = 0;         // mixed into every chance roll
+    std::vector<BotSkipRange> skipRanges;
+    std::array<uint8, MAX_CLASSES> classResetToLevel;
+    std::array<uint8, MAX_CLASSES> classChancePercent;
+    LevelDistributionTarget distribution;  // when active it replaces the roll chances and rolls every level-up in its bands
+
+    BotResetPolicyConfig()
+    {
+        classResetToLevel.fill(USE_DEFAULT);
+        classChancePercent.fill(USE_DEFAULT);
+    }
+
+    BotResetPolicyEntry const& GetEntry(uint8 level, uint8 playerClass) const
+    {
+        return _table[level][playerClass < MAX_CLASSES ? playerClass : uint8(CLASS_NONE)];
+    }
+
+    // Resolves the settings above into one entry per level and class. Must be called after any change.
+    void Compile()
+    {
+        using namespace BotResetPolicy;
+
+        // Chained ranges collapse into their final destination, 10:20 and 20:30 send a level 10 bot to 30
+        std::array<uint8, STRONG_MAX_LEVEL + 1> skipTo{};
+        for (BotSkipRange const& range : skipRanges)
+            skipTo[range.fromLevel] = range.toLevel;
+        std::array<uint8, STRONG_MAX_LEVEL + 1> skipDestination{};
+        for (uint32 level = 0; level <= STRONG_MAX_LEVEL; ++level)
+        {
+            uint8 destination = skipTo[level];
+            for (uint32 hops = 0; destination && skipTo[destination] && hops <= STRONG_MAX_LEVEL; ++hops)
+                destination = skipTo[destination];
+            skipDestination[level] = destination;
+        }
+
+        for (uint8 playerClass = 0; playerClass < MAX_CLASSES; ++playerClass)
+        {
+            uint8 const startLevel = GetClassStartLevel(playerClass);
+            uint8 const resetTarget = std::max(classResetToLevel[playerClass] != USE_DEFAULT ? classResetToLevel[playerClass] : resetToLevel, startLevel);
+            uint8 const chance = classChancePercent[playerClass] != USE_DEFAULT ? classChancePercent[playerClass] : chancePercent;
+
+            for (uint32 level = 0; level <= STRONG_MAX_LEVEL; ++level)
+            {
+                bool const atMax = maxLevel > 0 && level == maxLevel;
+                bool const aboveMax = maxLevel > 0 && level > maxLevel;
+                bool const atSkip = skipDestination[level] != 0;
+
+                BotResetPolicyEntry& entry = _table[level][playerClass];
+                entry.chance = ComputeResetChance(static_cast<uint8>(level), maxLevel, chance, scaledChance);
+                entry.targetLevel = atSkip ? std::max(skipDestination[level], startLevel) : resetTarget;
+
+                uint8& login = entry.rule[static_cast<uint8>(BotResetTrigger::Login)];
+                if (aboveMax)
+                    login = LEVEL_RULE_RESET;
+                else if (atMax)
+                    login = restrictByPlayedTime ? LEVEL_RULE_WAIT_PLAYED : LEVEL_RULE_ROLL;
+                else
+                    login = atSkip ? LEVEL_RULE_SKIP : LEVEL_RULE_NONE;
+
+                // The skip takes priority and is not affected by other settings. The level changes of a reset
+                // or skip itself never get here, the module ignores them while it randomizes the bot.
+                uint8& levelChanged = entry.rule[static_cast<uint8>(BotResetTrigger::LevelChanged)];
+                if (atSkip)
+                    levelChanged = LEVEL_RULE_SKIP;
+                else if (maxLevel == 0)
+                    levelChanged = LEVEL_RULE_NONE;
+                else if (aboveMax)
+                    levelChanged = LEVEL_RULE_RESET;
+                else if (atMax)
+                    levelChanged = restrictByPlayedTime ? LEVEL_RULE_WAIT_PLAYED : LEVEL_RULE_ROLL;
+                else if (scaledChance || (distribution.IsActive() && level >= distribution.firstLevel))
+                    levelChanged = LEVEL_RULE_ROLL;
+                else
+                    levelChanged = LEVEL_RULE_NONE;
+
+                // Turns into LEVEL_RULE_ROLL once the bot has played MinTimePlayed, see EvaluateLevelRule().
+                // Without the time restriction only bots held back by the reset cooldown are time-checked.
+                uint8& timeCheck = entry.rule[static_cast<uint8>(BotResetTrigger::TimeCheck)];
+                if (restrictByPlayedTime)
+                    timeCheck = (atMax || aboveMax) ? LEVEL_RULE_WAIT_PLAYED : LEVEL_RULE_NONE;
+                else
+                    timeCheck = aboveMax ? LEVEL_RULE_RESET : atMax ? LEVEL_RULE_ROLL : LEVEL_RULE_NONE;
+            }
+        }
+    }
+
+private:
+    std::array<std::array<BotResetPolicyEntry, MAX_CLASSES>, STRONG_MAX_LEVEL + 1> _table;
+};
+
+// Counter-based chance roll: a hash of the seed and the bot's GUID, level, trigger and epoch. It keeps no
+// state, can be computed on any thread and always comes out the same for the same inputs. The epoch is the
+// bot's total played time. It moves on between two evaluations of a bot, so a bot that failed its roll rolls
+// again at its next login or time-played check, and unlike the level played time it is not set back to 0
+// by a level-up, so a bot reaching the same level again after a reset gets a fresh roll. A login decision
+// made while the bot was offline rolls what the login hook would have rolled.
+inline uint8 ComputeResetRoll(uint32 seed, uint32 guid, uint8 level, BotResetTrigger trigger, uint32 epoch)
+{
+    uint64 key = (uint64(seed) << 32 | guid) ^ ((uint64(epoch) << 16 | uint64(level) << 8 | static_cast<uint8>(trigger)) * 0x9E3779B97F4A7C15ull);
+
+    // SplitMix64 finalizer
+    key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+    key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+    key ^= key >> 31;
+
+    // Scales the high 32 bits to 0-99 without the bias of a modulo
+    return static_cast<uint8>(((key >> 32) * 100) >> 32);
+}
+
+namespace BotResetPolicy
+{
+    inline LevelRule EvaluateLevelRule(BotResetPolicyEntry const& entry, uint32 levelPlayedTime, BotResetTrigger trigger, BotResetPolicyConfig const& config)
+    {
+        LevelRule rule = static_cast<LevelRule>(entry.rule[static_cast<uint8>(trigger)]);
+        if (trigger == BotResetTrigger::TimeCheck && rule == LEVEL_RULE_WAIT_PLAYED && levelPlayedTime >= config.minTimePlayed)
+            return LEVEL_RULE_ROLL;
+        return rule;
+    }
+
+    // Chance in percent a LEVEL_RULE_ROLL bot is reset with
+    inline uint8 GetRollChance(BotResetPolicyEntry const& entry, uint8 level, BotResetPolicyConfig const& config, LevelHistogram const& levels)
+    {
+        return config.distribution.IsActive() ? ComputeSteeredResetChance(levels, config.distribution, level) : entry.chance;
+    }
+
+    inline BotResetDecision Decide(LevelRule rule, BotResetPolicyEntry const& entry, BotSnapshot const& bot, BotResetTrigger trigger,
+        uint8 roll, uint8 chance, BotResetPolicyConfig const& config, RealPlayerGuildIndex const& guilds)
+    {
+        if (rule == LEVEL_RULE_NONE)
+            return { BotResetVerdict::None, BOT_RESET_FILTER_LEVEL, 0, 0 };
+        if (!(bot.flags & BOT_ELIGIBILITY_BOT))
+            return { BotResetVerdict::None, BOT_RESET_FILTER_NOT_BOT, 0, 0 };
+        if (!(bot.flags & BOT_ELIGIBILITY_RANDOM_BOT))
+            return { BotResetVerdict::None, BOT_RESET_FILTER_NOT_RANDOM_BOT, 0, 0 };
+        if (bot.flags & BOT_ELIGIBILITY_EXCLUDED)
+            return { BotResetVerdict::None, BOT_RESET_FILTER_EXCLUDED, 0, 0 };
+
+        if (config.ignoreGuildsWithRealPlayers && guilds.HasRealPlayer(bot.guildId))
+        {
+            // Real players may leave the guild, so a bot waiting on its time played is looked at again later
+            if (rule == LEVEL_RULE_WAIT_PLAYED || (trigger == BotResetTrigger::TimeCheck && rule == LEVEL_RULE_ROLL && config.restrictByPlayedTime))
+                return { BotResetVerdict::Defer, BOT_RESET_FILTER_GUILD, config.retryInterval, 0 };
+            return { BotResetVerdict::None, BOT_RESET_FILTER_GUILD, 0, 0 };
+        }
+
+        switch (rule)
+        {
+            case LEVEL_RULE_RESET:
+                return { BotResetVerdict::Reset, BOT_RESET_FILTER_PASSED, 0, entry.targetLevel };
+            case LEVEL_RULE_SKIP:
+                return { BotResetVerdict::Skip, BOT_RESET_FILTER_PASSED, 0, entry.targetLevel };
+            case LEVEL_RULE_WAIT_PLAYED:
+                return { BotResetVerdict::Defer, BOT_RESET_FILTER_PASSED,
+                         bot.levelPlayedTime >= config.minTimePlayed ? 0 : config.minTimePlayed - bot.levelPlayedTime, 0 };
+            default:
+                break;
+        }
+
+        if (roll < chance)
+            return { BotResetVerdict::Reset, BOT_RESET_FILTER_PASSED, 0, entry.targetLevel };
+        // A bot waiting on its time played that failed its roll tries again later, the hooks and the cooldown
+        // check only roll once per event
+        if (trigger == BotResetTrigger::TimeCheck && config.restrictByPlayedTime)
+            return { BotResetVerdict::Defer, BOT_RESET_FILTER_PASSED, config.retryInterval, 0 };
+        return { BotResetVerdict::None, BOT_RESET_FILTER_PASSED, 0, 0 };
+    }
+}
+
+inline BotResetDecision EvaluateBotReset(BotSnapshot const& bot, BotResetTrigger trigger,
+    BotResetPolicyConfig const& config, RealPlayerGuildIndex const& guilds, LevelHistogram const& levels)
+{
+    BotResetPolicyEntry const& entry = config.GetEntry(bot.level, bot.playerClass);
+    BotResetPolicy::LevelRule rule = BotResetPolicy::EvaluateLevelRule(entry, bot.levelPlayedTime, trigger, config);
+    uint8 roll = ComputeResetRoll(config.rollSeed, bot.guid, bot.level, trigger, bot.totalPlayedTime);
+    return BotResetPolicy::Decide(rule, entry, bot, trigger, roll, BotResetPolicy::GetRollChance(entry, bot.level, config, levels), config, guilds);
+}
+
+// Structure-of-arrays batch of snapshots. The level rules and the chance rolls run as tight passes over
+// the columns, the eligibility and guild stages only for the bots that pass the level rules.
+struct BotSnapshotBatch
+{
+    std::vector<uint32> guid;
+    std::vector<uint32> levelPlayedTime;
+    std::vector<uint32> totalPlayedTime;
+    std::vector<uint32> guildId;
+    std::vector<uint8> level;
+    std::vector<uint8> playerClass;
+    std::vector<uint8> flags;
+
+    std::size_t Size() const { return level.size(); }
+
+    void Add(BotSnapshot const& bot)
+    {
+        guid.push_back(bot.guid);
+        levelPlayedTime.push_back(bot.levelPlayedTime);
+        totalPlayedTime.push_back(bot.totalPlayedTime);
+        guildId.push_back(bot.guildId);
+        level.push_back(bot.level);
+        playerClass.push_back(bot.playerClass);
+        flags.push_back(bot.flags);
+    }
+
+    void Clear()
+    {
+        guid.clear();
+        levelPlayedTime.clear();
+        totalPlayedTime.clear();
+        guildId.clear();
+        level.clear();
+        playerClass.clear();
+        flags.clear();
+    }
+};
+
+inline void EvaluateBotResetBatch(BotSnapshotBatch const& batch, BotResetTrigger trigger, BotResetPolicyConfig const& config,
+    RealPlayerGuildIndex const& guilds, LevelHistogram const& levels, std::vector<BotResetDecision>& decisions)
+{
+    std::size_t const size = batch.Size();
+    std::vector<uint8> rules(size);
+    for (std::size_t i = 0; i < size; ++i)
+        rules[i] = BotResetPolicy::EvaluateLevelRule(config.GetEntry(batch.level[i], batch.playerClass[i]), batch.levelPlayedTime[i], trigger, config);
+
+    std::vector<uint8> rolls(size);
+    for (std::size_t i = 0; i < size; ++i)
+        rolls[i] = ComputeResetRoll(config.rollSeed, batch.guid[i], batch.level[i], trigger, batch.totalPlayedTime[i]);
+
+    decisions.assign(size, BotResetDecision{ BotResetVerdict::None, BOT_RESET_FILTER_LEVEL, 0, 0 });
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (rules[i] == BotResetPolicy::LEVEL_RULE_NONE)
+            continue;
+
+        BotSnapshot bot{ batch.guid[i], batch.levelPlayedTime[i], batch.totalPlayedTime[i], batch.guildId[i], batch.level[i],
+                         batch.playerClass[i], batch.flags[i] };
+        BotResetPolicyEntry const& entry = config.GetEntry(bot.level, bot.playerClass);
+        decisions[i] = BotResetPolicy::Decide(static_cast<BotResetPolicy::LevelRule>(rules[i]), entry, bot, trigger, rolls[i],
+                                              BotResetPolicy::GetRollChance(entry, bot.level, config, levels), config, guilds);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// RESET KIT CACHE
+// The equipment and spells a full PlayerbotFactory::Randomize gave a bot, kept per race, class, talent tree
+// and level. Later resets and skips to the same level apply one instead of selecting them again. Each key
+// holds up to ResetBotLevel.ResetKitVariants kits, filled by the first full Randomizes; a bot picks one of
+// them by its GUID, so bots of the same kind do not all end up with the same gear.
+// -----------------------------------------------------------------------------
+static constexpr std::size_t BOT_RESET_KIT_SLOTS = 19;      // EQUIPMENT_SLOT_END
+static constexpr uint8 BOT_RESET_KIT_TALENT_TREES = 3;      // MAX_TALENT_TABS
+
+struct BotResetKit
+{
+    std::array<uint32, BOT_RESET_KIT_SLOTS> items{};  // item entry per equipment slot, 0 for an empty slot
+    std::vector<uint32> spells;                        // sorted, talents not included
+};
+
+class BotResetKitCache
+{
+public:
+    // Drops every kit, they were built under the previous settings
+    void SetVariants(uint32 variants)
+    {
+        _variants = variants;
+        _kits.clear();
+        _size = 0;
+    }
+
+    bool IsEnabled() const { return _variants > 0; }
+
+    // Whether any talent tree of the race and class has its kits for the level, checked before the talents are picked
+    bool HasKits(uint8 race, uint8 playerClass, uint8 level) const
+    {
+        for (uint8 tree = 0; tree < BOT_RESET_KIT_TALENT_TREES; ++tree)
+            if (IsComplete(race, playerClass, tree, level))
+                return true;
+        return false;
+    }
+
+    // A key is only used once all its variants are built
+    bool IsComplete(uint8 race, uint8 playerClass, uint8 tree, uint8 level) const
+    {
+        auto itr = _kits.find(Key(race, playerClass, tree, level));
+        return IsEnabled() && itr != _kits.end() && itr->second.size() >= _variants;
+    }
+
+    BotResetKit const* Find(uint8 race, uint8 playerClass, uint8 tree, uint8 level, uint32 guid) const
+    {
+        if (!IsComplete(race, playerClass, tree, level))
+            return nullptr;
+
+        std::vector<BotResetKit> const& kits = _kits.find(Key(race, playerClass, tree, level))->second;
+        return &kits[(guid * 2654435761u >> 16) % kits.size()];
+    }
+
+    // Ignored once the key has all its variants
+    void Add(uint8 race, uint8 playerClass, uint8 tree, uint8 level, BotResetKit kit)
+    {
+        if (!IsEnabled())
+            return;
+
+        std::vector<BotResetKit>& kits = _kits[Key(race, playerClass, tree, level)];
+        if (kits.size() >= _variants)
+            return;
+
+        std::sort(kit.spells.begin(), kit.spells.end());
+        kits.push_back(std::move(kit));
+        ++_size;
+    }
+
+    std::size_t Size() const { return _size; }
+
+private:
+    static uint32 Key(uint8 race, uint8 playerClass, uint8 tree, uint8 level)
+    {
+        return uint32(race) << 24 | uint32(playerClass) << 16 | uint32(tree) << 8 | level;
+    }
+
+    std::unordered_map<uint32, std::vector<BotResetKit>> _kits;
+    uint32 _variants = 0;
+    std::size_t _size = 0;
+};
+
+// -----------------------------------------------------------------------------
+// LATENCY HISTOGRAM
+// Relaxed atomic log2 histogram, safe to record into from any thread.
+// -----------------------------------------------------------------------------
+class LatencyHistogram
+{
+public:
+    // Bucket i holds samples below 2^i microseconds, the last bucket holds everything above
+    static constexpr std::size_t BUCKETS = 25;
+
+    void Record(uint64 micros)
+    {
+        std::size_t bucket = 0;
+        while (bucket < BUCKETS - 1 && (uint64(1) << bucket) <= micros)
+            ++bucket;
+
+        _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        _count.fetch_add(1, std::memory_order_relaxed);
+        _total.fetch_add(micros, std::memory_order_relaxed);
+        uint64 max = _max.load(std::memory_order_relaxed);
+        while (micros > max && !_max.compare_exchange_weak(max, micros, std::memory_order_relaxed)) { }
+    }
+
+    uint64 Count() const { return _count.load(std::memory_order_relaxed); }
+    uint64 Max() const { return _max.load(std::memory_order_relaxed); }
+    uint64 Average() const
+    {
+        uint64 count = Count();
+        return count ? _total.load(std::memory_order_relaxed) / count : 0;
+    }
+
+    // Upper bound of the bucket holding the given percentile
+    uint64 Percentile(uint32 percent) const
+    {
+        uint64 count = Count();
+        if (!count)
+            return 0;
+
+        uint64 rank = (count * percent + 99) / 100;
+        uint64 seen = 0;
+        for (std::size_t bucket = 0; bucket < BUCKETS - 1; ++bucket)
+        {
+            seen += _buckets[bucket].load(std::memory_order_relaxed);
+            if (seen >= rank)
+                return uint64(1) << bucket;
+        }
+        return Max();
+    }
+
+    void Reset()
+    {
+        for (auto& bucket : _buckets)
+            bucket.store(0, std::memory_order_relaxed);
+        _count.store(0, std::memory_order_relaxed);
+        _total.store(0, std::memory_order_relaxed);
+        _max.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<uint64>, BUCKETS> _buckets{};
+    std::atomic<uint64> _count{ 0 };
+    std::atomic<uint64> _total{ 0 };
+    std::atomic<uint64> _max{ 0 };
+};
+
+// -----------------------------------------------------------------------------
+// ADAPTIVE WORK THROTTLE
+// Scales the reset work done per world update by the update diff. The average diff is an exponential
+// moving average over roughly the last eight updates. Above the target the scale drops by a quarter per
+// update down to SCALE_MIN, at or below half the target it climbs back up to twice the configured work, in
+// between it returns to the configured work. Below 100% the work only runs on that share of the updates,
+// since the budgets always let at least one bot through; above 100% the budgets are raised. The floor keeps
+// the queue draining on a server that never gets under the target.
+// -----------------------------------------------------------------------------
+class AdaptiveWorkThrottle
+{
+public:
+    static constexpr uint32 SCALE_NORMAL = 100;  // percent of the configured work
+    static constexpr uint32 SCALE_MIN = 10;
+    static constexpr uint32 SCALE_MAX = 200;
+    static constexpr uint32 SCALE_STEP = 5;      // percent regained per update
+
+    // Called once per world update before any throttled work; targetDiff 0 disables the throttle
+    void Update(uint32 diff, uint32 targetDiff)
+    {
+        // Sixteenths of a millisecond, so small diffs still move the average
+        _averageDiff16 = _averageDiff16 - _averageDiff16 / 8 + uint64(diff) * 2;
+
+        uint32 averageDiff = GetAverageDiff();
+        if (targetDiff == 0)
+            _scale = SCALE_NORMAL;
+        else if (averageDiff > targetDiff)
+            _scale = std::max(_scale - std::max<uint32>(_scale / 4, 1), SCALE_MIN);
+        else if (averageDiff * 2 <= targetDiff)
+            _scale = std::min(_scale + SCALE_STEP, SCALE_MAX);
+        else if (_scale < SCALE_NORMAL)
+            _scale = std::min(_scale + SCALE_STEP, SCALE_NORMAL);
+        else
+            _scale = std::max(_scale - SCALE_STEP, SCALE_NORMAL);
+
+        // Each update earns its scale in credit, a turn costs the configured work
+        _credit = std::min(_credit + _scale, SCALE_NORMAL + SCALE_MAX);
+        _hasTurn = _credit >= SCALE_NORMAL;
+        if (_hasTurn)
+            _credit -= SCALE_NORMAL;
+    }
+
+    // Whether throttled work may run during this update
+    bool HasTurn() const { return _hasTurn; }
+
+    // Raises a per-update limit while catching up, 0 stays unlimited
+    uint32 ScaleLimit(uint32 limit) const
+    {
+        return _scale > SCALE_NORMAL ? uint32(uint64(limit) * _scale / SCALE_NORMAL) : limit;
+    }
+
+    uint32 GetScale() const { return _scale; }
+    uint32 GetAverageDiff() const { return uint32(_averageDiff16 / 16); }
+
+private:
+    uint64 _averageDiff16 = 0;
+    uint32 _scale = SCALE_NORMAL;
+    uint32 _credit = 0;
+    bool _hasTurn = true;
+};
+
+// -----------------------------------------------------------------------------
+// DEBUG LOG BUFFERING
+// Fixed capacity ring and per message type rate limiter behind the debug log. Neither is synchronised,
+// the owner guards both with its own lock.
+// -----------------------------------------------------------------------------
+template<typename T>
+class BoundedRing
+{
+public:
+    explicit BoundedRing(std::size_t capacity) : _items(capacity) { }
+
+    std::size_t Size() const { return _size; }
+    bool Empty() const { return _size == 0; }
+
+    // Returns false, leaving the ring untouched, when it is full
+    bool Push(T const& item)
+    {
+        if (_size == _items.size())
+            return false;
+
+        _items[(_head + _size) % _items.size()] = item;
+        ++_size;
+        return true;
+    }
+
+    void PopAll(std::vector<T>& out)
+    {
+        for (; _size > 0; --_size)
+        {
+            out.push_back(_items[_head]);
+            _head = (_head + 1) % _items.size();
+        }
+    }
+
+private:
+    std::vector<T> _items;
+    std::size_t _head = 0;
+    std::size_t _size = 0;
+};
+
+class LogRateLimiter
+{
+public:
+    explicit LogRateLimiter(std::size_t types) : _windows(types) { }
+
+    // Allows up to limitPerSecond messages of a type per second, 0 allows all of them
+    bool Allow(std::size_t type, uint32 nowMs, uint32 limitPerSecond)
+    {
+        Window& window = _windows[type];
+        if (nowMs - window.start >= 1000)
+        {
+            window.start = nowMs;
+            window.count = 0;
+        }
+
+        if (limitPerSecond > 0 && window.count >= limitPerSecond)
+        {
+            ++window.suppressed;
+            return false;
+        }
+
+        ++window.count;
+        return true;
+    }
+
+    // Number of messages of a type refused since the last call
+    uint32 TakeSuppressed(std::size_t type)
+    {
+        return std::exchange(_windows[type].suppressed, 0);
+    }
+
+private:
+    struct Window
+    {
+        uint32 start = 0;
+        uint32 count = 0;
+        uint32 suppressed = 0;
+    };
+
+    std::vector<Window> _windows;
+};
+
+#endif // MOD_PLAYER_BOT_RESET_CORE_H
@@ -1,13 +1,16 @@
 #include "mod-player-bot-reset.h"
+#include "mod-player-bot-reset-core.h"
 #include "ScriptMgr.h"
 #include "Player.h"
 #include "Common.h"
 #include "Chat.h"
+#include "ChatCommand.h"
 #include "Log.h"
 #include "PlayerbotAIBase.h"
 #include "Configuration/Config.h"
 #include "PlayerbotMgr.h"
 #include "PlayerbotAI.h"
+#include "PlayerbotAIConfig.h"
 #include "AutoMaintenanceOnLevelupAction.h"
 #include "ObjectMgr.h"
 #include "WorldSession.h"
@@ -15,114 +18,462 @@
 #include "RandomPlayerbotMgr.h"
 #include "ObjectAccessor.h"
 #include "PlayerbotFactory.h"
+#include "AiFactory.h"
+#include "DBCStores.h"
 #include "DatabaseEnv.h"
+#include "AsyncCallbackProcessor.h"
+#include "Guild.h"
+#include "GameTime.h"
+#include "StringConvert.h"
+#include "Timer.h"
+#include "Util.h"
 #include <vector>
 #include <string>
 #include <sstream>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
 #include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 // -----------------------------------------------------------------------------
-// GLOBALS: Configuration Values
+// CONFIGURATION
+// All settings live in one immutable snapshot. LoadPlayerBotResetConfig() builds a new one on startup
+// and on .reload config and publishes it with an atomic pointer swap. Readers take the snapshot once
+// per hook or world tick, so they never see a mix of old and new settings.
 // -----------------------------------------------------------------------------
-static uint8 g_ResetBotMaxLevel      = 80;
-static uint8 g_ResetToLevel          = 1;
-static uint8 g_SkipFromLevel         = 0;
-static uint8 g_SkipToLevel           = 1;
-static uint8 g_ResetBotChancePercent = 100;
-static bool  g_DebugMode             = false;
-static bool  g_ScaledChance          = false;
+struct PlayerBotResetConfig
+{
+    uint8 maxLevel      = 80;
+    uint8 resetToLevel  = 1;
+    uint8 skipFromLevel = 0;
+    uint8 skipToLevel   = 1;
+    uint8 chancePercent = 100;
+    bool  debugMode     = false;
+    bool  scaledChance  = false;
+
+    // When true, bots at maxLevel are reset only after they have accumulated at least
+    // minTimePlayed seconds at that level. Bots above maxLevel are reset right away.
+    bool   restrictByPlayedTime     = false;
+    uint32 minTimePlayed            = 86400;  // in seconds (1 Day)
+    uint32 playedTimeCheckFrequency = 864;    // in seconds (retry interval after a failed reset roll)
+    // Due time-played checks are spread over many world ticks; 0 disables the respective limit.
+    uint32 sweepBotsPerTick         = 100;
+    uint32 sweepTimeBudgetUs        = 1000;   // in microseconds
+
+    // Reset and skip decisions are queued and carried out under a per-tick time budget; 0 disables the limit.
+    uint32 resetQueueTimeBudgetUs   = 2000;   // in microseconds
+
+    // Offline random bots are evaluated ahead of their login this often; 0 disables the scan.
+    uint32 pendingResetScanInterval = 0;      // in seconds
+
+    // Resets and skips are recorded in bot_reset_history; a bot is not reset again within resetCooldown seconds.
+    bool   resetHistory             = true;
+    uint32 historyFlushInterval     = 60;     // in seconds
+    uint32 resetCooldown            = 0;      // in seconds, 0 disables the cooldown
+
+    // Queued resets and time-played checks back off while the average world update diff is above this; 0 disables.
+    uint32 throttleTargetDiff       = 0;      // in milliseconds, 0 disables the throttle
+
+    // Mixed into every chance roll, the same seed and bot state always roll the same
+    uint32 rollSeed                 = 0;
+
+    // Kits kept per race, class, talent tree and level for resets that skip the full Randomize; 0 disables them.
+    uint32 resetKitVariants         = 0;
+
+    // Exclusion settings
+    bool ignoreGuildBotsWithRealPlayers = false;
+    BotNameExclusions excludeNames;
+    uint32 guildTrackerFlushInterval    = 600;  // in seconds
+    uint32 guildTrackerTTL              = 2592000;  // in seconds (30 days), 0 keeps guilds forever
+    // Guilds with real characters, online or not, are read from guild_member at startup and then periodically
+    bool   guildReconcile               = false;
+    uint32 guildReconcileInterval       = 86400;    // in seconds, 0 reconciles at startup only
+
+    // Debug log sampling and rate limiting, only used with debugMode
+    uint8 debugSampleRate  = 100;   // percent of bots whose events are logged
+    BotNameExclusions debugBotNames; // bots that are always logged, matched like excludeNames
+    uint32 debugRateLimit  = 20;    // messages per type and second, 0 disables the limit
+
+    // Settings read by the reset policy, compiled from the values above
+    BotResetPolicyConfig policy;
+};
+
+using PlayerBotResetConfigPtr = std::shared_ptr<PlayerBotResetConfig const>;
+
+// Holds the defaults until the first load, their policy table is empty so no bot is touched. Only accessed
+// through the shared_ptr atomic functions: readers copy the pointer out and keep using their snapshot while
+// a reload swaps in a new one.
+static PlayerBotResetConfigPtr g_Config = std::make_shared<PlayerBotResetConfig const>();
 
-// When true, bots at g_ResetBotMaxLevel are reset only after they have accumulated at least
-// g_MinTimePlayed seconds at that level. Bots above g_ResetBotMaxLevel are reset right away.
-static bool  g_RestrictResetByPlayedTime  = false;
-static uint32 g_MinTimePlayed             = 86400;  // in seconds (1 Day)
-static uint32 g_PlayedTimeCheckFrequency  = 864;    // in seconds (default check frequency)
+static PlayerBotResetConfigPtr GetConfig()
+{
+    return std::atomic_load(&g_Config);
+}
 
-// Exclusion settings
-static bool g_IgnoreGuildBotsWithRealPlayers = false;
-static std::vector<std::string> g_ExcludeBotNames;
+// Guilds with real players - online ones from the hooks, offline ones from the persistent tracker table
+static RealPlayerGuildIndex g_RealPlayerGuilds;
 
-// Persistent guild tracker - stores guild IDs that have real players (from database)
-static std::unordered_set<uint32> g_PersistentRealPlayerGuildIds;
+// Every random bot character, see RANDOM BOT ROSTER
+static RandomBotRoster g_RandomBotRoster;
 
 // -----------------------------------------------------------------------------
 // LOAD CONFIGURATION USING sConfigMgr
 // -----------------------------------------------------------------------------
-static void LoadPlayerBotResetConfig()
+
+// Reads a comma-separated list of "Key:Value" pairs, e.g. "6:55, 11:20". Malformed entries are logged and skipped.
+static std::vector<std::pair<uint32, uint32>> LoadConfigPairList(std::string const& option, uint32& errors)
 {
-    g_ResetBotMaxLevel = static_cast<uint8>(sConfigMgr->GetOption<uint32>("ResetBotLevel.MaxLevel", 80));
-    if ((g_ResetBotMaxLevel < 2 || g_ResetBotMaxLevel > 80) && g_ResetBotMaxLevel != 0)
+    std::vector<std::pair<uint32, uint32>> pairs;
+    std::istringstream list(sConfigMgr->GetOption<std::string>(option, ""));
+    std::string item;
+    while (getline(list, item, ','))
     {
-        LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.MaxLevel value: {}. Using default value 80.", g_ResetBotMaxLevel);
-        g_ResetBotMaxLevel = 80;
+        item.erase(std::remove_if(item.begin(), item.end(), ::isspace), item.end());
+        if (item.empty())
+            continue;
+
+        std::size_t separator = item.find(':');
+        Optional<uint32> key = separator != std::string::npos ? Acore::StringTo<uint32>(item.substr(0, separator)) : std::nullopt;
+        Optional<uint32> value = separator != std::string::npos ? Acore::StringTo<uint32>(item.substr(separator + 1)) : std::nullopt;
+        if (!key || !value)
+        {
+            LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid {} entry: '{}'. Expected Key:Value, ignoring it.", option, item);
+            ++errors;
+            continue;
+        }
+
+        pairs.emplace_back(*key, *value);
+    }
+    return pairs;
+}
+
+// Reads a comma-separated list of names or wildcard patterns into a matcher
+static void LoadConfigNameList(std::string const& option, BotNameExclusions& names)
+{
+    names.Clear();
+    std::istringstream f(sConfigMgr->GetOption<std::string>(option, ""));
+    std::string s;
+    while (getline(f, s, ',')) {
+        s.erase(std::remove_if(s.begin(), s.end(), ::isspace), s.end());
+        if (!s.empty()) {
+            names.Add(s);
+        }
     }
+}
 
-    g_ResetToLevel = static_cast<uint8>(sConfigMgr->GetOption<uint32>("ResetBotLevel.ResetToLevel", 1));
-    if (g_ResetToLevel < 1 || (g_ResetBotMaxLevel > 0 && g_ResetToLevel >= g_ResetBotMaxLevel))
+static bool AddSkipRange(std::vector<BotSkipRange>& ranges, uint8 maxLevel, uint32 fromLevel, uint32 toLevel)
+{
+    if (fromLevel < 1 || fromLevel > 80 || (maxLevel > 0 && fromLevel >= maxLevel) ||
+        toLevel < 1 || toLevel > 80 || (maxLevel > 0 && toLevel > maxLevel) || fromLevel == toLevel)
     {
-        LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.ResetToLevel value: {}. Using default value 1.", g_ResetToLevel);
-        g_ResetToLevel = 1;
+        LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.SkipRanges entry: {}:{}. Ignoring it.", fromLevel, toLevel);
+        return false;
     }
 
-    g_SkipFromLevel = static_cast<uint8>(sConfigMgr->GetOption<uint32>("ResetBotLevel.SkipFromLevel", 0));
-    if (g_SkipFromLevel > 80 || (g_ResetBotMaxLevel > 0 && g_SkipFromLevel >= g_ResetBotMaxLevel))
+    for (BotSkipRange const& range : ranges)
     {
-        LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.SkipFromLevel value: {}. Using default value 0 (disabled).", g_SkipFromLevel);
-        g_SkipFromLevel = 0;
+        if (range.fromLevel == fromLevel)
+        {
+            LOG_ERROR("server.loading", "[mod-player-bot-reset] ResetBotLevel.SkipRanges entry {}:{} repeats level {}. Ignoring it.", fromLevel, toLevel, fromLevel);
+            return false;
+        }
     }
 
-    g_SkipToLevel = static_cast<uint8>(sConfigMgr->GetOption<uint32>("ResetBotLevel.SkipToLevel", 1));
-    if (g_SkipToLevel < 1 || g_SkipToLevel > 80 || (g_ResetBotMaxLevel > 0 && g_SkipToLevel > g_ResetBotMaxLevel))
+    // Following the existing ranges from the destination must never lead back to fromLevel
+    uint32 destination = toLevel;
+    for (std::size_t hops = 0; hops < ranges.size(); ++hops)
     {
-        LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.SkipToLevel value: {}. Using default value 1.", g_SkipToLevel);
-        g_SkipToLevel = 1;
+        auto next = std::find_if(ranges.begin(), ranges.end(), [destination](BotSkipRange const& range) { return range.fromLevel == destination; });
+        if (next == ranges.end())
+            break;
+
+        destination = next->toLevel;
+        if (destination == fromLevel)
+        {
+            LOG_ERROR("server.loading", "[mod-player-bot-reset] ResetBotLevel.SkipRanges entry {}:{} creates a loop. Ignoring it.", fromLevel, toLevel);
+            return false;
+        }
     }
 
-    g_ResetBotChancePercent = static_cast<uint8>(sConfigMgr->GetOption<uint32>("ResetBotLevel.ResetChance", 100));
-    if (g_ResetBotChancePercent > 100)
+    ranges.push_back({ static_cast<uint8>(fromLevel), static_cast<uint8>(toLevel) });
+    return true;
+}
+
+// On startup invalid settings fall back to their defaults. On reload any invalid setting keeps the
+// previous configuration in place, so a typo cannot take down a running realm's settings.
+static bool LoadPlayerBotResetConfig(bool reload)
+{
+    auto config = std::make_shared<PlayerBotResetConfig>();
+    uint32 errors = 0;
+
+    config->maxLevel = static_cast<uint8>(sConfigMgr->GetOption<uint32>("ResetBotLevel.MaxLevel", 80));
+    if ((config->maxLevel < 2 || config->maxLevel > 80) && config->maxLevel != 0)
     {
-        LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.ResetChance value: {}. Using default value 100.", g_ResetBotChancePercent);
-        g_ResetBotChancePercent = 100;
+        LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.MaxLevel value: {}. Using default value 80.", config->maxLevel);
+        config->maxLevel = 80;
+        ++errors;
     }
 
-    g_DebugMode   = sConfigMgr->GetOption<bool>("ResetBotLevel.DebugMode", false);
-    g_ScaledChance = sConfigMgr->GetOption<bool>("ResetBotLevel.ScaledChance", false);
+    config->resetToLevel = static_cast<uint8>(sConfigMgr->GetOption<uint32>("ResetBotLevel.ResetToLevel", 1));
+    if (config->resetToLevel < 1 || (config->maxLevel > 0 && config->resetToLevel >= config->maxLevel))
+    {
+        LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.ResetToLevel value: {}. Using default value 1.", config->resetToLevel);
+        config->resetToLevel = 1;
+        ++errors;
+    }
 
-    g_RestrictResetByPlayedTime = sConfigMgr->GetOption<bool>("ResetBotLevel.RestrictTimePlayed", false);
-    g_MinTimePlayed             = sConfigMgr->GetOption<uint32>("ResetBotLevel.MinTimePlayed", 86400);
-    g_PlayedTimeCheckFrequency  = sConfigMgr->GetOption<uint32>("ResetBotLevel.PlayedTimeCheckFrequency", 864);
+    config->skipFromLevel = static_cast<uint8>(sConfigMgr->GetOption<uint32>("ResetBotLevel.SkipFromLevel", 0));
+    if (config->skipFromLevel > 80 || (config->maxLevel > 0 && config->skipFromLevel >= config->maxLevel))
+    {
+        LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.SkipFromLevel value: {}. Using default value 0 (disabled).", config->skipFromLevel);
+        config->skipFromLevel = 0;
+        ++errors;
+    }
 
-    g_IgnoreGuildBotsWithRealPlayers = sConfigMgr->GetOption<bool>("ResetBotLevel.IgnoreGuildBotsWithRealPlayers", false);
+    config->skipToLevel = static_cast<uint8>(sConfigMgr->GetOption<uint32>("ResetBotLevel.SkipToLevel", 1));
+    if (config->skipToLevel < 1 || config->skipToLevel > 80 || (config->maxLevel > 0 && config->skipToLevel > config->maxLevel))
+    {
+        LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.SkipToLevel value: {}. Using default value 1.", config->skipToLevel);
+        config->skipToLevel = 1;
+        ++errors;
+    }
 
-    std::string excludeNames = sConfigMgr->GetOption<std::string>("ResetBotLevel.ExcludeNames", "");
-    g_ExcludeBotNames.clear();
-    std::istringstream f(excludeNames);
-    std::string s;
-    while (getline(f, s, ',')) {
-        s.erase(std::remove_if(s.begin(), s.end(), ::isspace), s.end());
-        if (!s.empty()) {
-            g_ExcludeBotNames.push_back(s);
+    config->chancePercent = static_cast<uint8>(sConfigMgr->GetOption<uint32>("ResetBotLevel.ResetChance", 100));
+    if (config->chancePercent > 100)
+    {
+        LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.ResetChance value: {}. Using default value 100.", config->chancePercent);
+        config->chancePercent = 100;
+        ++errors;
+    }
+
+    config->debugMode    = sConfigMgr->GetOption<bool>("ResetBotLevel.DebugMode", false);
+    config->scaledChance = sConfigMgr->GetOption<bool>("ResetBotLevel.ScaledChance", false);
+
+    config->restrictByPlayedTime     = sConfigMgr->GetOption<bool>("ResetBotLevel.RestrictTimePlayed", false);
+    config->minTimePlayed            = sConfigMgr->GetOption<uint32>("ResetBotLevel.MinTimePlayed", 86400);
+    config->playedTimeCheckFrequency = sConfigMgr->GetOption<uint32>("ResetBotLevel.PlayedTimeCheckFrequency", 864);
+    config->sweepBotsPerTick         = sConfigMgr->GetOption<uint32>("ResetBotLevel.SweepBotsPerTick", 100);
+    config->sweepTimeBudgetUs        = sConfigMgr->GetOption<uint32>("ResetBotLevel.SweepTimeBudget", 1000);
+    config->resetQueueTimeBudgetUs   = sConfigMgr->GetOption<uint32>("ResetBotLevel.ResetQueueTimeBudget", 2000);
+    config->pendingResetScanInterval = sConfigMgr->GetOption<uint32>("ResetBotLevel.PendingResetScanInterval", 0);
+    config->throttleTargetDiff       = sConfigMgr->GetOption<uint32>("ResetBotLevel.ThrottleTargetDiff", 0);
+    config->rollSeed                 = sConfigMgr->GetOption<uint32>("ResetBotLevel.RollSeed", 0);
+    config->resetKitVariants         = sConfigMgr->GetOption<uint32>("ResetBotLevel.ResetKitVariants", 0);
+    config->resetHistory             = sConfigMgr->GetOption<bool>("ResetBotLevel.ResetHistory", true);
+    config->historyFlushInterval     = sConfigMgr->GetOption<uint32>("ResetBotLevel.HistoryFlushInterval", 60);
+    if (config->historyFlushInterval == 0)
+    {
+        LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.HistoryFlushInterval value: {}. Using default value 60.", config->historyFlushInterval);
+        config->historyFlushInterval = 60;
+        ++errors;
+    }
+    config->resetCooldown            = sConfigMgr->GetOption<uint32>("ResetBotLevel.ResetCooldown", 0);
+
+    config->ignoreGuildBotsWithRealPlayers = sConfigMgr->GetOption<bool>("ResetBotLevel.IgnoreGuildBotsWithRealPlayers", false);
+    config->guildTrackerFlushInterval = sConfigMgr->GetOption<uint32>("ResetBotLevel.GuildTrackerFlushInterval", 600);
+    if (config->guildTrackerFlushInterval == 0)
+    {
+        LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.GuildTrackerFlushInterval value: {}. Using default value 600.", config->guildTrackerFlushInterval);
+        config->guildTrackerFlushInterval = 600;
+        ++errors;
+    }
+    config->guildTrackerTTL = sConfigMgr->GetOption<uint32>("ResetBotLevel.GuildTrackerTTL", 2592000);
+    config->guildReconcile = sConfigMgr->GetOption<bool>("ResetBotLevel.GuildReconcile", false);
+    config->guildReconcileInterval = sConfigMgr->GetOption<uint32>("ResetBotLevel.GuildReconcileInterval", 86400);
+
+    LoadConfigNameList("ResetBotLevel.ExcludeNames", config->excludeNames);
+
+    config->debugSampleRate = static_cast<uint8>(sConfigMgr->GetOption<uint32>("ResetBotLevel.DebugSampleRate", 100));
+    if (config->debugSampleRate > 100)
+    {
+        LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.DebugSampleRate value: {}. Using default value 100.", config->debugSampleRate);
+        config->debugSampleRate = 100;
+        ++errors;
+    }
+    LoadConfigNameList("ResetBotLevel.DebugBotNames", config->debugBotNames);
+    config->debugRateLimit = sConfigMgr->GetOption<uint32>("ResetBotLevel.DebugRateLimit", 20);
+
+    BotResetPolicyConfig& policy = config->policy;
+    policy.maxLevel = config->maxLevel;
+    policy.resetToLevel = config->resetToLevel;
+    policy.chancePercent = config->chancePercent;
+    policy.scaledChance = config->scaledChance;
+    policy.restrictByPlayedTime = config->restrictByPlayedTime;
+    policy.ignoreGuildsWithRealPlayers = config->ignoreGuildBotsWithRealPlayers;
+    policy.minTimePlayed = config->minTimePlayed;
+    policy.retryInterval = config->playedTimeCheckFrequency;
+    policy.rollSeed = config->rollSeed;
+
+    // SkipFromLevel/SkipToLevel is kept as the first skip range
+    if (config->skipFromLevel > 0 && !AddSkipRange(policy.skipRanges, config->maxLevel, config->skipFromLevel, config->skipToLevel))
+        ++errors;
+    for (auto const& [fromLevel, toLevel] : LoadConfigPairList("ResetBotLevel.SkipRanges", errors))
+    {
+        if (!AddSkipRange(policy.skipRanges, config->maxLevel, fromLevel, toLevel))
+            ++errors;
+    }
+
+    for (auto const& [playerClass, level] : LoadConfigPairList("ResetBotLevel.ClassResetToLevel", errors))
+    {
+        if (playerClass == CLASS_NONE || playerClass >= MAX_CLASSES || level < 1 || (config->maxLevel > 0 && level >= config->maxLevel))
+        {
+            LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.ClassResetToLevel entry: {}:{}. Ignoring it.", playerClass, level);
+            ++errors;
+            continue;
         }
+        policy.classResetToLevel[playerClass] = static_cast<uint8>(level);
     }
+
+    for (auto const& [playerClass, chance] : LoadConfigPairList("ResetBotLevel.ClassResetChance", errors))
+    {
+        if (playerClass == CLASS_NONE || playerClass >= MAX_CLASSES || chance > 100)
+        {
+            LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.ClassResetChance entry: {}:{}. Ignoring it.", playerClass, chance);
+            ++errors;
+            continue;
+        }
+        policy.classChancePercent[playerClass] = static_cast<uint8>(chance);
+    }
+
+    // Each weight holds from its level up to the next listed level, the last one up to MaxLevel
+    std::vector<std::pair<uint32, uint32>> distribution = LoadConfigPairList("ResetBotLevel.TargetDistribution", errors);
+    std::sort(distribution.begin(), distribution.end());
+    for (std::size_t i = 0; i < distribution.size(); ++i)
+    {
+        auto const [fromLevel, weight] = distribution[i];
+        if (config->maxLevel == 0 || fromLevel < 1 || fromLevel > config->maxLevel || (i > 0 && distribution[i - 1].first == fromLevel))
+        {
+            LOG_ERROR("server.loading", "[mod-player-bot-reset] Invalid ResetBotLevel.TargetDistribution entry: {}:{}. Ignoring it.", fromLevel, weight);
+            ++errors;
+            continue;
+        }
+
+        if (policy.distribution.firstLevel == 0)
+            policy.distribution.firstLevel = static_cast<uint8>(fromLevel);
+
+        uint32 toLevel = i + 1 < distribution.size() ? std::min<uint32>(distribution[i + 1].first - 1, config->maxLevel) : config->maxLevel;
+        for (uint32 level = fromLevel; level <= toLevel; ++level)
+        {
+            policy.distribution.weight[level] = weight;
+            policy.distribution.totalWeight += weight;
+        }
+    }
+
+    if (reload && errors > 0)
+    {
+        LOG_ERROR("server.loading", "[mod-player-bot-reset] Configuration reload rejected, {} invalid settings. The previous configuration stays active.", errors);
+        return false;
+    }
+
+    policy.Compile();
+
+    LOG_INFO("server.loading", "[mod-player-bot-reset] {} with MaxLevel = {} ({}), ResetToLevel = {}, SkipRanges = {}, ResetChance = {}, ScaledChance = {}, IgnoreGuildBotsWithRealPlayers = {}, ExcludedNames = {}.",
+             reload ? "Reloaded" : "Loaded and active",
+             static_cast<int>(config->maxLevel),
+             config->maxLevel > 0 ? "Enabled" : "Disabled",
+             static_cast<int>(config->resetToLevel),
+             policy.skipRanges.size(),
+             policy.distribution.IsActive() ? "steered by TargetDistribution" : std::to_string(config->chancePercent) + "%",
+             config->scaledChance ? "Enabled" : "Disabled",
+             config->ignoreGuildBotsWithRealPlayers ? "Enabled" : "Disabled",
+             config->excludeNames.Empty() ? "None" : std::to_string(config->excludeNames.Size()) + " names");
+
+    std::atomic_store(&g_Config, PlayerBotResetConfigPtr(std::move(config)));
+    return true;
 }
 
 // -----------------------------------------------------------------------------
-// UTILITY FUNCTIONS: Detect if a Player is a Bot
+// INSTRUMENTATION
+// Relaxed atomic counters and log2 latency histograms. They are cheap enough to leave on in production,
+// can be bumped from map threads and are read with the .botreset stats command.
 // -----------------------------------------------------------------------------
-static bool IsPlayerBot(Player* player)
+class ScopedLatency
 {
-    if (!player)
+public:
+    explicit ScopedLatency(LatencyHistogram& histogram) : _histogram(histogram), _start(std::chrono::steady_clock::now()) { }
+    ~ScopedLatency()
     {
-        LOG_ERROR("server.loading", "[mod-player-bot-reset] IsPlayerBot called with nullptr.");
-        return false;
+        _histogram.Record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start).count());
+    }
+
+private:
+    LatencyHistogram& _histogram;
+    std::chrono::steady_clock::time_point _start;
+};
+
+enum BotResetHook : uint8
+{
+    BOT_RESET_HOOK_LOGIN,
+    BOT_RESET_HOOK_LEVEL_CHANGED,
+    BOT_RESET_HOOK_TIME_CHECK,
+    MAX_BOT_RESET_HOOK
+};
+
+static char const* const BotResetHookNames[MAX_BOT_RESET_HOOK] = { "OnPlayerLogin", "OnLevelChanged", "OnUpdate" };
+static char const* const BotResetFilterNames[MAX_BOT_RESET_FILTER] = { "level", "real player", "not a random bot", "excluded", "guild with real players", "passed" };
+static char const* const BotResetClassNames[MAX_CLASSES] = { "", "Warrior", "Paladin", "Hunter", "Rogue", "Priest", "Death Knight", "Shaman", "Mage", "Warlock", "", "Druid" };
+
+struct BotResetStats
+{
+    std::array<std::array<std::atomic<uint64>, MAX_BOT_RESET_FILTER>, MAX_BOT_RESET_HOOK> hookFilters{};
+    std::atomic<uint64> levelChanges{ 0 };  // level change events, coalesced into the OnLevelChanged evaluations
+    std::array<std::atomic<uint64>, STRONG_MAX_LEVEL + 1> resetsByLevel{};
+    std::array<std::atomic<uint64>, STRONG_MAX_LEVEL + 1> skipsByLevel{};
+    std::array<std::atomic<uint64>, MAX_CLASSES> resetsByClass{};
+    std::array<std::atomic<uint64>, MAX_CLASSES> skipsByClass{};
+    LatencyHistogram randomize;
+    std::array<LatencyHistogram, MAX_CLASSES> randomizeByClass;  // the cost of Randomize differs a lot between classes
+    LatencyHistogram resetKit;                                   // resets and skips handed a cached kit instead
+    LatencyHistogram timeCheck;
+    LatencyHistogram guildTrackerFlush;
+
+    void Reset()
+    {
+        for (auto& hook : hookFilters)
+            for (auto& counter : hook)
+                counter.store(0, std::memory_order_relaxed);
+        levelChanges.store(0, std::memory_order_relaxed);
+        for (auto* counters : { &resetsByLevel, &skipsByLevel })
+            for (auto& counter : *counters)
+                counter.store(0, std::memory_order_relaxed);
+        for (auto* counters : { &resetsByClass, &skipsByClass })
+            for (auto& counter : *counters)
+                counter.store(0, std::memory_order_relaxed);
+        randomize.Reset();
+        for (LatencyHistogram& histogram : randomizeByClass)
+            histogram.Reset();
+        resetKit.Reset();
+        timeCheck.Reset();
+        guildTrackerFlush.Reset();
     }
+};
+
+static BotResetStats g_Stats;
 
-    PlayerbotAI* botAI = sPlayerbotsMgr->GetPlayerbotAI(player);
-    return botAI && botAI->IsBotAI();
+static void CountHookFilter(BotResetHook hook, BotResetFilter filter)
+{
+    g_Stats.hookFilters[hook][filter].fetch_add(1, std::memory_order_relaxed);
 }
 
+static void CountLevelChange(bool skip, uint8 level, uint8 playerClass)
+{
+    (skip ? g_Stats.skipsByLevel : g_Stats.resetsByLevel)[level].fetch_add(1, std::memory_order_relaxed);
+    if (playerClass < MAX_CLASSES)
+        (skip ? g_Stats.skipsByClass : g_Stats.resetsByClass)[playerClass].fetch_add(1, std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+// UTILITY FUNCTIONS: Detect if a Player is a Bot
+// -----------------------------------------------------------------------------
 static bool IsPlayerRandomBot(Player* player)
 {
     if (!player)
@@ -133,224 +484,1363 @@ static bool IsPlayerRandomBot(Player* player)
     return sRandomPlayerbotMgr->IsRandomBot(player);
 }
 
+// A bot the roster holds for its account is a random bot without asking the playerbots manager
+static bool IsRosterRandomBot(Player* player)
+{
+    RandomBotRecord const* record = g_RandomBotRoster.Find(player->GetGUID().GetCounter());
+    return record && player->GetSession() && record->account == player->GetSession()->GetAccountId();
+}
+
 // -----------------------------------------------------------------------------
-// EXCLUSION FUNCTIONS
+// REAL PLAYER DETECTION
 // -----------------------------------------------------------------------------
-static bool IsBotExcluded(Player* bot)
+// The bot AI is attached only after the login hooks ran, so real players are told apart by their session.
+static bool IsRealPlayerSession(Player* player)
 {
-    if (!bot)
+    return player && player->GetSession() && !player->GetSession()->IsBot();
+}
+
+// -----------------------------------------------------------------------------
+// ELIGIBILITY CACHE
+// Built once per player in OnPlayerLogin and dropped at logout. It is only updated by the events that
+// can change it: the guild membership hooks, a configuration reload and the random bot flag, which is
+// re-validated before every reset decision about an online bot since playerbots offers no hook for a
+// random bot being turned into an alt or back.
+// Guild protection depends on other players, so the record keeps the guild ID and the protection is
+// read from the guild index when it is needed.
+// -----------------------------------------------------------------------------
+static constexpr uint32 BOT_NOT_ELIGIBLE = std::numeric_limits<uint32>::max();
+
+struct BotEligibility
+{
+    uint32 guildId;
+    uint32 eligibleIndex;  // position in g_EligibleBots, BOT_NOT_ELIGIBLE when not listed
+    uint8 flags;           // BotEligibilityFlags
+    uint8 level;           // level the bot is counted at in g_LevelHistogram while it is eligible
+
+    bool IsBot() const { return flags & BOT_ELIGIBILITY_BOT; }
+    bool IsRandomBot() const { return flags & BOT_ELIGIBILITY_RANDOM_BOT; }
+    bool IsExcluded() const { return flags & BOT_ELIGIBILITY_EXCLUDED; }
+    bool IsEligible() const { return IsBot() && IsRandomBot() && !IsExcluded(); }
+};
+
+static std::unordered_map<ObjectGuid::LowType, BotEligibility> g_BotEligibility;
+// Dense list of the online random bots that are not excluded
+static std::vector<ObjectGuid::LowType> g_EligibleBots;
+// Levels of the bots in g_EligibleBots
+static LevelHistogram g_LevelHistogram;
+
+static void UpdateEligibleBotList(ObjectGuid::LowType guid, BotEligibility& record)
+{
+    if (record.IsEligible() && record.eligibleIndex == BOT_NOT_ELIGIBLE)
     {
-        return false;
+        record.eligibleIndex = static_cast<uint32>(g_EligibleBots.size());
+        g_EligibleBots.push_back(guid);
+        g_LevelHistogram.Add(record.level);
     }
-    const std::string& name = bot->GetName();
-    for (const auto& excluded : g_ExcludeBotNames)
+    else if (!record.IsEligible() && record.eligibleIndex != BOT_NOT_ELIGIBLE)
     {
-        if (excluded == name)
-        {
-            return true;
-        }
+        // Swap with the last entry to keep the list dense
+        ObjectGuid::LowType last = g_EligibleBots.back();
+        g_EligibleBots[record.eligibleIndex] = last;
+        g_BotEligibility.find(last)->second.eligibleIndex = record.eligibleIndex;
+        g_EligibleBots.pop_back();
+        record.eligibleIndex = BOT_NOT_ELIGIBLE;
+        g_LevelHistogram.Remove(record.level);
     }
-    return false;
 }
 
-static bool BotInGuildWithRealPlayer(Player* bot)
+// Flags that only depend on the configuration, recomputed for every online player on reload
+static uint8 GetConfigEligibilityFlags(Player* player, PlayerBotResetConfig const& config)
 {
-    if (!bot || !bot->IsInWorld())
+    uint8 flags = 0;
+    if (config.excludeNames.Matches(player->GetName()))
+        flags |= BOT_ELIGIBILITY_EXCLUDED;
+
+    // The sample is picked by GUID so a sampled bot is logged from login to logout
+    if (config.debugMode && (config.debugBotNames.Matches(player->GetName()) ||
+        (player->GetGUID().GetCounter() * 2654435761u) % 100 < config.debugSampleRate))
+        flags |= BOT_ELIGIBILITY_DEBUG_LOG;
+    return flags;
+}
+
+static BotEligibility const& BuildBotEligibility(Player* player, PlayerBotResetConfig const& config)
+{
+    uint8 flags = GetConfigEligibilityFlags(player, config);
+    if (!IsRealPlayerSession(player))
     {
-        return false;
+        flags |= BOT_ELIGIBILITY_BOT;
+        if (IsRosterRandomBot(player) || IsPlayerRandomBot(player))
+            flags |= BOT_ELIGIBILITY_RANDOM_BOT;
     }
-    uint32 guildId = bot->GetGuildId();
-    if (guildId == 0)
+
+    ObjectGuid::LowType guid = player->GetGUID().GetCounter();
+    BotEligibility& record = g_BotEligibility.try_emplace(guid, BotEligibility{ 0, BOT_NOT_ELIGIBLE, 0, 0 }).first->second;
+    if (record.eligibleIndex != BOT_NOT_ELIGIBLE && record.level != player->GetLevel())
+        g_LevelHistogram.Move(record.level, player->GetLevel());
+    record.level = player->GetLevel();
+    record.guildId = player->GetGuildId();
+    record.flags = flags;
+    UpdateEligibleBotList(guid, record);
+    return record;
+}
+
+static void DropBotEligibility(ObjectGuid::LowType guid)
+{
+    auto itr = g_BotEligibility.find(guid);
+    if (itr == g_BotEligibility.end())
+        return;
+
+    itr->second.flags = 0;
+    UpdateEligibleBotList(guid, itr->second);
+    g_BotEligibility.erase(itr);
+}
+
+static BotEligibility const* GetBotEligibility(Player* player)
+{
+    auto itr = g_BotEligibility.find(player->GetGUID().GetCounter());
+    return itr != g_BotEligibility.end() ? &itr->second : nullptr;
+}
+
+static void SetBotEligibilityGuild(ObjectGuid::LowType guid, uint32 guildId)
+{
+    auto itr = g_BotEligibility.find(guid);
+    if (itr != g_BotEligibility.end())
+        itr->second.guildId = guildId;
+}
+
+static void SetBotEligibilityLevel(ObjectGuid::LowType guid, uint8 level)
+{
+    auto itr = g_BotEligibility.find(guid);
+    if (itr == g_BotEligibility.end() || itr->second.level == level)
+        return;
+
+    if (itr->second.eligibleIndex != BOT_NOT_ELIGIBLE)
+        g_LevelHistogram.Move(itr->second.level, level);
+    itr->second.level = level;
+}
+
+static void RefreshBotEligibility(PlayerBotResetConfig const& config)
+{
+    for (auto& [guid, record] : g_BotEligibility)
     {
-        return false;
+        Player* player = ObjectAccessor::FindPlayer(ObjectGuid::Create<HighGuid::Player>(guid));
+        if (!player)
+            continue;
+
+        record.flags = (record.flags & ~(BOT_ELIGIBILITY_EXCLUDED | BOT_ELIGIBILITY_DEBUG_LOG)) | GetConfigEligibilityFlags(player, config);
+        UpdateEligibleBotList(guid, record);
     }
+}
 
-    // Check online players for real players in the same guild
-    auto const& allPlayers = ObjectAccessor::GetPlayers();
-    for (auto const& itr : allPlayers)
+static void SetBotEligibilityRandomBot(ObjectGuid::LowType guid, bool randomBot)
+{
+    auto itr = g_BotEligibility.find(guid);
+    if (itr == g_BotEligibility.end() || !itr->second.IsBot() || itr->second.IsRandomBot() == randomBot)
+        return;
+
+    if (randomBot)
+        itr->second.flags |= BOT_ELIGIBILITY_RANDOM_BOT;
+    else
+        itr->second.flags &= ~BOT_ELIGIBILITY_RANDOM_BOT;
+    UpdateEligibleBotList(guid, itr->second);
+}
+
+// -----------------------------------------------------------------------------
+// DEBUG LOG
+// With ResetBotLevel.DebugMode the hooks only copy a small record into a bounded ring. A background thread formats
+// the records and writes them under the module.player_bot_reset log category. Bot events are sampled
+// per bot, each message type is rate limited, and suppressed or dropped messages are reported as counts.
+// -----------------------------------------------------------------------------
+static char const* const BOT_RESET_LOG_CATEGORY = "module.player_bot_reset";
+static constexpr std::size_t BOT_RESET_LOG_RING_SIZE = 4096;
+static constexpr std::chrono::seconds BOT_RESET_LOG_INTERVAL(1);
+static constexpr std::size_t BOT_RESET_LOG_NAME_SIZE = 12 * 4 + 1;   // 12 characters of up to 4 UTF-8 bytes, and the terminator
+
+enum BotResetLogEvent : uint8
+{
+    BOT_RESET_LOG_DECISION,     // hook, level, verdict, filter, defer seconds
+    BOT_RESET_LOG_RESET,        // class, level, target level
+    BOT_RESET_LOG_SKIP,         // class, level, target level
+    BOT_RESET_LOG_QUEUE,        // processed, still queued, last latency ms, max latency ms
+    BOT_RESET_LOG_GUILD_LOAD,   // loaded guilds
+    BOT_RESET_LOG_GUILD_FLUSH,  // refreshed guilds, expired guilds, tracked guilds
+    BOT_RESET_LOG_GUILD_RECONCILE, // guilds found, chunks read, elapsed ms
+    BOT_RESET_LOG_PENDING_SCAN, // bots scanned, pending decisions, elapsed ms
+    BOT_RESET_LOG_THROTTLE,     // scale percent, average diff ms, target diff ms
+    BOT_RESET_LOG_COOLDOWN,     // level, cooldown seconds left
+    BOT_RESET_LOG_ROSTER_LOAD,  // bots loaded, chunks read, elapsed ms
+    MAX_BOT_RESET_LOG_EVENT
+};
+
+static char const* const BotResetLogEventNames[MAX_BOT_RESET_LOG_EVENT] = { "decision", "reset", "skip", "reset queue", "guild tracker load", "guild tracker flush",
+                                                                                   "guild reconciliation", "pending reset scan", "throttle",
+                                                                                   "reset cooldown", "random bot roster load" };
+
+struct BotResetLogRecord
+{
+    BotResetLogEvent event;
+    std::array<char, BOT_RESET_LOG_NAME_SIZE> name;  // bot name, empty for events that are not about a bot
+    std::array<uint32, 5> values;                    // see BotResetLogEvent
+};
+
+static void WriteBotResetLogRecord(BotResetLogRecord const& record)
+{
+    static char const* const verdictNames[] = { "no action", "reset", "skip", "deferred" };
+    auto const& v = record.values;
+    switch (record.event)
     {
-        Player* player = itr.second;
-        if (!player || !player->IsInWorld())
-            continue;
+        case BOT_RESET_LOG_DECISION:
+            LOG_INFO(BOT_RESET_LOG_CATEGORY, "[mod-player-bot-reset] {}: Bot '{}' at level {}: {} ({}{}).",
+                     BotResetHookNames[v[0]], record.name.data(), v[1], verdictNames[v[2]], BotResetFilterNames[v[3]],
+                     v[2] == static_cast<uint32>(BotResetVerdict::Defer) ? ", next check in " + std::to_string(v[4]) + " seconds" : "");
+            break;
+        case BOT_RESET_LOG_RESET:
+            LOG_INFO(BOT_RESET_LOG_CATEGORY, "[mod-player-bot-reset] ResetBot: Bot '{}' - {} at level {} was reset to level {}.",
+                     record.name.data(), BotResetClassNames[v[0]], v[1], v[2]);
+            break;
+        case BOT_RESET_LOG_SKIP:
+            LOG_INFO(BOT_RESET_LOG_CATEGORY, "[mod-player-bot-reset] SkipBotLevel: Bot '{}' - {} at level {} was skipped to level {}.",
+                     record.name.data(), BotResetClassNames[v[0]], v[1], v[2]);
+            break;
+        case BOT_RESET_LOG_QUEUE:
+            LOG_INFO(BOT_RESET_LOG_CATEGORY, "[mod-player-bot-reset] ProcessResetQueue: Processed {} bots, {} still queued, last drain latency {} ms (max {} ms).",
+                     v[0], v[1], v[2], v[3]);
+            break;
+        case BOT_RESET_LOG_GUILD_LOAD:
+            LOG_INFO(BOT_RESET_LOG_CATEGORY, "[mod-player-bot-reset] Loaded {} guilds with real players from persistent storage.", v[0]);
+            break;
+        case BOT_RESET_LOG_GUILD_FLUSH:
+            LOG_INFO(BOT_RESET_LOG_CATEGORY, "[mod-player-bot-reset] Persistent guild tracker update complete. Refreshed {} guilds, expired {}, {} total tracked guilds.",
+                     v[0], v[1], v[2]);
+            break;
+        case BOT_RESET_LOG_GUILD_RECONCILE:
+            LOG_INFO(BOT_RESET_LOG_CATEGORY, "[mod-player-bot-reset] Guild reconciliation complete. Found {} guilds with real characters in {} chunks ({} ms).",
+                     v[0], v[1], v[2]);
+            break;
+        case BOT_RESET_LOG_THROTTLE:
+            LOG_INFO(BOT_RESET_LOG_CATEGORY, "[mod-player-bot-reset] Reset throttle at {}% of the configured work (average update diff {} ms, target {} ms).",
+                     v[0], v[1], v[2]);
+            break;
+        case BOT_RESET_LOG_COOLDOWN:
+            LOG_INFO(BOT_RESET_LOG_CATEGORY, "[mod-player-bot-reset] Bot {} at level {} was reset too recently, checking it again in {} seconds.",
+                     record.name.data(), v[0], v[1]);
+            break;
+        case BOT_RESET_LOG_ROSTER_LOAD:
+            LOG_INFO(BOT_RESET_LOG_CATEGORY, "[mod-player-bot-reset] Random bot roster loaded. Read {} random bot characters in {} chunks ({} ms).",
+                     v[0], v[1], v[2]);
+            break;
+        case BOT_RESET_LOG_PENDING_SCAN:
+            LOG_INFO(BOT_RESET_LOG_CATEGORY, "[mod-player-bot-reset] Pending reset scan complete. Scanned {} offline bots, {} login decisions pending ({} ms).",
+                     v[0], v[1], v[2]);
+            break;
+        default:
+            break;
+    }
+}
+
+class BotResetDebugLog
+{
+public:
+    ~BotResetDebugLog() { Stop(); }
+
+    void Start()
+    {
+        if (_thread.joinable())
+            return;
+
+        _stopping = false;
+        _thread = std::thread(&BotResetDebugLog::Run, this);
+    }
+
+    void Stop()
+    {
+        if (!_thread.joinable())
+            return;
 
-        if (!IsPlayerBot(player) && player->GetGuildId() == guildId)
         {
-            return true;
+            std::lock_guard<std::mutex> guard(_lock);
+            _stopping = true;
         }
+        _wake.notify_one();
+        _thread.join();
     }
 
-    // Check persistent storage for offline real players
-    return g_PersistentRealPlayerGuildIds.count(guildId) > 0;
+    // Safe to call from map threads, the record is dropped when the ring is full
+    void Push(BotResetLogRecord const& record, uint32 rateLimit)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if (!_limiter.Allow(record.event, getMSTime(), rateLimit))
+            return;
+        if (!_ring.Push(record))
+            ++_dropped;
+    }
+
+private:
+    void Run()
+    {
+        std::vector<BotResetLogRecord> records;
+        std::array<uint32, MAX_BOT_RESET_LOG_EVENT> suppressed{};
+        bool stopping = false;
+        while (!stopping)
+        {
+            uint64 dropped;
+            {
+                std::unique_lock<std::mutex> lock(_lock);
+                _wake.wait_for(lock, BOT_RESET_LOG_INTERVAL, [this] { return _stopping; });
+                stopping = _stopping;
+                _ring.PopAll(records);
+                for (uint8 event = 0; event < MAX_BOT_RESET_LOG_EVENT; ++event)
+                    suppressed[event] = _limiter.TakeSuppressed(event);
+                dropped = std::exchange(_dropped, 0);
+            }
+
+            for (BotResetLogRecord const& record : records)
+                WriteBotResetLogRecord(record);
+            records.clear();
+
+            for (uint8 event = 0; event < MAX_BOT_RESET_LOG_EVENT; ++event)
+            {
+                if (suppressed[event])
+                    LOG_INFO(BOT_RESET_LOG_CATEGORY, "[mod-player-bot-reset] {} {} messages suppressed by ResetBotLevel.DebugRateLimit.",
+                             suppressed[event], BotResetLogEventNames[event]);
+            }
+            if (dropped)
+                LOG_INFO(BOT_RESET_LOG_CATEGORY, "[mod-player-bot-reset] {} messages dropped, the debug log buffer was full.", dropped);
+        }
+    }
+
+    std::mutex _lock;
+    std::condition_variable _wake;
+    BoundedRing<BotResetLogRecord> _ring{ BOT_RESET_LOG_RING_SIZE };
+    LogRateLimiter _limiter{ MAX_BOT_RESET_LOG_EVENT };
+    uint64 _dropped = 0;
+    bool _stopping = false;
+    std::thread _thread;
+};
+
+static BotResetDebugLog g_DebugLog;
+
+// Queues a debug log record. Events about a bot are only logged for the bots picked by the sampling,
+// read from the eligibility cache, so this must be called from the world thread.
+static void LogBotResetEvent(PlayerBotResetConfig const& config, BotResetLogEvent event, Player* bot, std::array<uint32, 5> const& values)
+{
+    BotResetLogRecord record{ event, {}, values };
+    if (bot)
+    {
+        BotEligibility const* eligibility = GetBotEligibility(bot);
+        if (!eligibility || !(eligibility->flags & BOT_ELIGIBILITY_DEBUG_LOG))
+            return;
+        bot->GetName().copy(record.name.data(), record.name.size() - 1);
+    }
+    g_DebugLog.Push(record, config.debugRateLimit);
 }
 
 // -----------------------------------------------------------------------------
 // PERSISTENT GUILD TRACKING FUNCTIONS
+// The table is read once at startup without blocking it; until the rows arrive every guild counts as
+// protected. Each flush writes the guilds new to the tracker, refreshes last_updated for the guilds real
+// players were seen in once their row is a quarter of ResetBotLevel.GuildTrackerTTL old, and deletes the
+// rows not refreshed within the TTL.
 // -----------------------------------------------------------------------------
+static constexpr std::size_t GUILD_TRACKER_BATCH_SIZE = 500;   // rows per REPLACE or DELETE statement
+
+static QueryCallbackProcessor g_GuildTrackerCallbacks;
+
 static void LoadPersistentGuildTracker()
 {
-    g_PersistentRealPlayerGuildIds.clear();
-    QueryResult result = CharacterDatabase.Query("SELECT guild_id FROM bot_reset_guild_tracker WHERE has_real_players = 1");
+    g_GuildTrackerCallbacks.AddCallback(CharacterDatabase.AsyncQuery(
+        "SELECT guild_id, CAST(UNIX_TIMESTAMP(last_updated) AS UNSIGNED) FROM bot_reset_guild_tracker WHERE has_real_players = 1")
+        .WithCallback([](QueryResult result)
+    {
+        std::vector<RealPlayerGuildIndex::StoredGuild> guilds;
+        if (result)
+        {
+            guilds.reserve(result->GetRowCount());
+            do
+            {
+                Field* fields = result->Fetch();
+                guilds.push_back({ fields[0].Get<uint32>(), static_cast<uint32>(fields[1].Get<uint64>()) });
+            } while (result->NextRow());
+        }
+        g_RealPlayerGuilds.LoadStoredGuilds(std::move(guilds));
+
+        PlayerBotResetConfigPtr config = GetConfig();
+        if (config->debugMode)
+        {
+            LogBotResetEvent(*config, BOT_RESET_LOG_GUILD_LOAD, nullptr, { static_cast<uint32>(g_RealPlayerGuilds.GetTrackedGuildCount()) });
+        }
+    }));
+}
+
+static void UpdatePersistentGuildTracker(PlayerBotResetConfig const& config)
+{
+    // Rows not loaded yet would look expired
+    if (!g_RealPlayerGuilds.IsStoredLoaded())
+        return;
+
+    ScopedLatency timer(g_Stats.guildTrackerFlush);
+
+    // A guild that stays online has its row rewritten once a quarter of the TTL has passed, well before it
+    // could expire, instead of on every flush
+    uint32 now = static_cast<uint32>(GameTime::GetGameTime().count());
+    uint32 refreshAge = config.guildTrackerTTL / 4;
+    std::vector<uint32> touched;
+    g_RealPlayerGuilds.TakeTouchedGuilds(now, refreshAge > 0 && now > refreshAge ? now - refreshAge : 0, touched);
+    std::vector<uint32> expired;
+    if (config.guildTrackerTTL > 0 && now > config.guildTrackerTTL)
+        g_RealPlayerGuilds.TakeExpiredGuilds(now - config.guildTrackerTTL, expired);
+
+    // Both lists are written in batches of multi-row statements, committed asynchronously as one transaction
+    if (!touched.empty() || !expired.empty())
+    {
+        CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+        for (std::size_t start = 0; start < touched.size(); start += GUILD_TRACKER_BATCH_SIZE)
+        {
+            std::ostringstream query;
+            query << "REPLACE INTO bot_reset_guild_tracker (guild_id, has_real_players) VALUES ";
+            for (std::size_t i = start; i < std::min(touched.size(), start + GUILD_TRACKER_BATCH_SIZE); ++i)
+                query << (i > start ? "," : "") << '(' << touched[i] << ",1)";
+            trans->Append(query.str());
+        }
+        for (std::size_t start = 0; start < expired.size(); start += GUILD_TRACKER_BATCH_SIZE)
+        {
+            std::ostringstream query;
+            query << "DELETE FROM bot_reset_guild_tracker WHERE guild_id IN (";
+            for (std::size_t i = start; i < std::min(expired.size(), start + GUILD_TRACKER_BATCH_SIZE); ++i)
+                query << (i > start ? "," : "") << expired[i];
+            query << ')';
+            trans->Append(query.str());
+        }
+        CharacterDatabase.CommitTransaction(trans);
+    }
+
+    if (config.debugMode)
+    {
+        LogBotResetEvent(config, BOT_RESET_LOG_GUILD_FLUSH, nullptr, { static_cast<uint32>(touched.size()), static_cast<uint32>(expired.size()),
+                                                                       static_cast<uint32>(g_RealPlayerGuilds.GetTrackedGuildCount()) });
+    }
+}
+
+// -----------------------------------------------------------------------------
+// GUILD RECONCILIATION
+// Reads every guild with a member on a non random-bot account straight from guild_member, so guilds whose
+// real players are all offline are protected without waiting for one of them to log in. The guild IDs are
+// read in ascending chunks on the database worker, each chunk query is issued by the callback of the
+// previous one.
+// -----------------------------------------------------------------------------
+static constexpr uint32 GUILD_RECONCILE_CHUNK_SIZE = 1000;   // guild IDs per query
+
+static bool g_GuildReconcileRunning = false;
+
+// Comma-separated IDs of the playerbots random bot accounts, empty when none are known
+static std::string GetRandomBotAccountList()
+{
+    std::ostringstream list;
+    std::vector<uint32> const& accounts = sPlayerbotAIConfig->randomBotAccounts;
+    for (std::size_t i = 0; i < accounts.size(); ++i)
+        list << (i > 0 ? "," : "") << accounts[i];
+    return list.str();
+}
+
+static void QueryGuildReconcileChunk(std::shared_ptr<std::string const> accountFilter, uint32 afterGuildId, uint32 found, uint32 chunks, uint32 startTime)
+{
+    std::ostringstream query;
+    query << "SELECT gm.guildid FROM guild_member gm INNER JOIN characters c ON c.guid = gm.guid WHERE gm.guildid > " << afterGuildId
+          << " AND c.account NOT IN (" << *accountFilter << ") GROUP BY gm.guildid ORDER BY gm.guildid LIMIT " << GUILD_RECONCILE_CHUNK_SIZE;
 
-    if (!result)
+    g_GuildTrackerCallbacks.AddCallback(CharacterDatabase.AsyncQuery(query.str())
+        .WithCallback([accountFilter, found, chunks, startTime](QueryResult result)
     {
-        if (g_DebugMode)
+        std::vector<uint32> guildIds;
+        if (result)
+        {
+            guildIds.reserve(result->GetRowCount());
+            do
+            {
+                guildIds.push_back(result->Fetch()[0].Get<uint32>());
+            } while (result->NextRow());
+            g_RealPlayerGuilds.AddReconciledGuilds(guildIds);
+        }
+
+        // A full chunk means there may be more, continue after its last guild
+        if (guildIds.size() == GUILD_RECONCILE_CHUNK_SIZE)
+        {
+            QueryGuildReconcileChunk(accountFilter, guildIds.back(), found + GUILD_RECONCILE_CHUNK_SIZE, chunks + 1, startTime);
+            return;
+        }
+
+        g_GuildReconcileRunning = false;
+
+        PlayerBotResetConfigPtr config = GetConfig();
+        if (config->debugMode)
         {
-            LOG_INFO("server.loading", "[mod-player-bot-reset] No guilds with real players found in persistent storage.");
+            LogBotResetEvent(*config, BOT_RESET_LOG_GUILD_RECONCILE, nullptr, { found + static_cast<uint32>(guildIds.size()), chunks + 1,
+                                                                                GetMSTimeDiffToNow(startTime) });
         }
+    }));
+}
+
+static void StartGuildReconciliation()
+{
+    if (g_GuildReconcileRunning)
+        return;
+
+    // Without random bot accounts every character would count as real and protect every guild
+    std::string accountFilter = GetRandomBotAccountList();
+    if (accountFilter.empty())
+    {
+        LOG_WARN("server.loading", "[mod-player-bot-reset] No random bot accounts are known, skipping guild reconciliation.");
         return;
     }
 
-    if (g_DebugMode)
+    g_GuildReconcileRunning = true;
+    QueryGuildReconcileChunk(std::make_shared<std::string const>(std::move(accountFilter)), 0, 0, 0, getMSTime());
+}
+
+// -----------------------------------------------------------------------------
+// RANDOM BOT ROSTER
+// The characters on the playerbots random bot accounts are read once at startup in ascending GUID chunks,
+// each chunk query issued by the callback of the previous one; the offline scans wait for the last one.
+// The login hook only asks the playerbots manager about bots the roster does not hold yet, such as the ones
+// created after startup. The hooks keep the records current: login and logout, level changes, resets and
+// guild membership.
+// -----------------------------------------------------------------------------
+static constexpr uint32 RANDOM_BOT_ROSTER_CHUNK_SIZE = 5000;   // characters per query
+
+static QueryCallbackProcessor g_RandomBotRosterCallbacks;
+
+static void QueryRandomBotRosterChunk(std::shared_ptr<std::string const> accounts, uint32 afterGuid, uint32 loaded, uint32 chunks, uint32 startTime)
+{
+    std::ostringstream query;
+    query << "SELECT c.guid, c.account, COALESCE(gm.guildid, 0), c.leveltime, c.totaltime, c.level, c.class FROM characters c "
+          << "LEFT JOIN guild_member gm ON gm.guid = c.guid WHERE c.guid > " << afterGuid << " AND c.account IN (" << *accounts
+          << ") ORDER BY c.guid LIMIT " << RANDOM_BOT_ROSTER_CHUNK_SIZE;
+
+    g_RandomBotRosterCallbacks.AddCallback(CharacterDatabase.AsyncQuery(query.str())
+        .WithCallback([accounts, loaded, chunks, startTime](QueryResult result)
     {
-        LOG_INFO("server.loading", "[mod-player-bot-reset] Loading persistent guild tracker data from database...");
+        std::vector<RandomBotRecord> rows;
+        if (result)
+        {
+            rows.reserve(result->GetRowCount());
+            do
+            {
+                Field* fields = result->Fetch();
+                rows.push_back(RandomBotRecord{ fields[0].Get<uint32>(), fields[1].Get<uint32>(), fields[2].Get<uint32>(),
+                                                fields[3].Get<uint32>(), fields[4].Get<uint32>(), fields[5].Get<uint8>(),
+                                                fields[6].Get<uint8>(), false });
+            } while (result->NextRow());
+            g_RandomBotRoster.LoadRecords(rows);
+        }
+
+        // A full chunk means there may be more, continue after its last character
+        if (rows.size() == RANDOM_BOT_ROSTER_CHUNK_SIZE)
+        {
+            QueryRandomBotRosterChunk(accounts, rows.back().guid, loaded + RANDOM_BOT_ROSTER_CHUNK_SIZE, chunks + 1, startTime);
+            return;
+        }
+
+        g_RandomBotRoster.SetLoaded();
+
+        PlayerBotResetConfigPtr config = GetConfig();
+        if (config->debugMode)
+        {
+            LogBotResetEvent(*config, BOT_RESET_LOG_ROSTER_LOAD, nullptr, { loaded + static_cast<uint32>(rows.size()), chunks + 1,
+                                                                            GetMSTimeDiffToNow(startTime) });
+        }
+    }));
+}
+
+static void LoadRandomBotRoster()
+{
+    std::string accounts = GetRandomBotAccountList();
+    if (accounts.empty())
+    {
+        LOG_WARN("server.loading", "[mod-player-bot-reset] No random bot accounts are known, the random bot roster is not loaded.");
+        return;
     }
 
-    do
+    QueryRandomBotRosterChunk(std::make_shared<std::string const>(std::move(accounts)), 0, 0, 0, getMSTime());
+}
+
+static void StoreRandomBotRecord(RandomBotRecord& record, Player* player, bool online)
+{
+    record.account = player->GetSession() ? player->GetSession()->GetAccountId() : record.account;
+    record.guildId = player->GetGuildId();
+    record.levelPlayedTime = player->GetLevelPlayedTime();
+    record.totalPlayedTime = player->GetTotalPlayedTime();
+    record.level = player->GetLevel();
+    record.playerClass = player->getClass();
+    record.online = online;
+}
+
+// Updates the bot's record if the roster holds one
+static void RefreshRandomBotRecord(Player* player, bool online)
+{
+    if (RandomBotRecord* record = g_RandomBotRoster.Find(player->GetGUID().GetCounter()))
+        StoreRandomBotRecord(*record, player, online);
+}
+
+static void SetRandomBotGuild(ObjectGuid::LowType guid, uint32 guildId)
+{
+    if (RandomBotRecord* record = g_RandomBotRoster.Find(guid))
+        record->guildId = guildId;
+}
+
+// Asks the playerbots manager again whether the bot is a random bot and moves it in or out of the roster
+// and the eligible bot list when that changed
+static void RevalidateRandomBot(Player* player)
+{
+    ObjectGuid::LowType guid = player->GetGUID().GetCounter();
+    BotEligibility const* eligibility = GetBotEligibility(player);
+    if (!eligibility || !eligibility->IsBot())
+        return;
+
+    bool const randomBot = IsPlayerRandomBot(player);
+    if (randomBot == eligibility->IsRandomBot())
+        return;
+
+    SetBotEligibilityRandomBot(guid, randomBot);
+    if (randomBot)
+        StoreRandomBotRecord(g_RandomBotRoster.Upsert(guid), player, true);
+    else
+        g_RandomBotRoster.Remove(guid);
+}
+
+// -----------------------------------------------------------------------------
+// PENDING LOGIN DECISIONS
+// Every ResetBotLevel.PendingResetScanInterval seconds the offline bots of the random bot roster at a level
+// with a login rule are run through the reset policy as one batch, roll included. The decisions that passed
+// every filter are kept by GUID, so a bot logging in only needs a hash lookup and its reset goes straight to
+// the deferred reset queue. Each offline bot has at most one decision, a later scan replaces it, so a bot
+// still gets a single roll per login. The roster holds no names, ResetBotLevel.ExcludeNames is applied when
+// the decision is taken at login.
+// -----------------------------------------------------------------------------
+struct PendingLoginDecision
+{
+    uint8 level;               // level the decision was made at
+    BotResetDecision decision;
+};
+
+static std::unordered_map<ObjectGuid::LowType, PendingLoginDecision> g_PendingLoginDecisions;
+
+static void ScanPendingLoginDecisions(PlayerBotResetConfig const& config)
+{
+    uint32 startTime = getMSTime();
+    std::vector<ObjectGuid::LowType> guids;
+    BotSnapshotBatch batch;
+    for (RandomBotRecord const& record : g_RandomBotRoster.Records())
+    {
+        // Bots online have been looked at by the login hook
+        if (record.online ||
+            config.policy.GetEntry(record.level, record.playerClass).rule[static_cast<uint8>(BotResetTrigger::Login)] == BotResetPolicy::LEVEL_RULE_NONE)
+            continue;
+
+        guids.push_back(record.guid);
+        batch.Add(BotSnapshot{ record.guid, record.levelPlayedTime, record.totalPlayedTime, record.guildId, record.level, record.playerClass,
+                               BOT_ELIGIBILITY_BOT | BOT_ELIGIBILITY_RANDOM_BOT });
+    }
+
+    bool const steering = config.policy.distribution.IsActive();
+    std::vector<BotResetDecision> decisions;
+    EvaluateBotResetBatch(batch, BotResetTrigger::Login, config.policy, g_RealPlayerGuilds, g_LevelHistogram, decisions);
+    for (std::size_t i = 0; i < guids.size(); ++i)
+    {
+        // Decisions that depend on time, on the guild or on the online population are left to the login hook
+        bool const steered = steering && config.policy.GetEntry(batch.level[i], batch.playerClass[i])
+            .rule[static_cast<uint8>(BotResetTrigger::Login)] == BotResetPolicy::LEVEL_RULE_ROLL;
+        if (decisions[i].filter == BOT_RESET_FILTER_PASSED && decisions[i].verdict != BotResetVerdict::Defer && !steered)
+            g_PendingLoginDecisions[guids[i]] = { batch.level[i], decisions[i] };
+        else
+            g_PendingLoginDecisions.erase(guids[i]);
+    }
+
+    if (config.debugMode)
+    {
+        LogBotResetEvent(config, BOT_RESET_LOG_PENDING_SCAN, nullptr, { static_cast<uint32>(guids.size()),
+                                                                        static_cast<uint32>(g_PendingLoginDecisions.size()),
+                                                                        GetMSTimeDiffToNow(startTime) });
+    }
+}
+
+// Hands out the decision made for the bot while it was offline, if it still applies
+static bool TakePendingLoginDecision(Player* player, BotEligibility const& eligibility, PlayerBotResetConfig const& config, BotResetDecision& decision)
+{
+    auto itr = g_PendingLoginDecisions.find(player->GetGUID().GetCounter());
+    if (itr == g_PendingLoginDecisions.end())
+        return false;
+
+    PendingLoginDecision pending = itr->second;
+    g_PendingLoginDecisions.erase(itr);
+
+    if (pending.level != player->GetLevel() || !eligibility.IsEligible())
+        return false;
+    if (config.policy.ignoreGuildsWithRealPlayers && g_RealPlayerGuilds.HasRealPlayer(eligibility.guildId))
+        return false;
+
+    decision = pending.decision;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// HELPER FUNCTION: Randomize a Bot at a New Level
+// -----------------------------------------------------------------------------
+// The bot being randomized, if any. Randomize() levels the bot and so fires OnPlayerLevelChanged for it,
+// those events are the reset itself and are ignored. A reset or skip never starts inside another one.
+static std::atomic<ObjectGuid::LowType> g_RandomizingBot{ 0 };
+
+// With ResetBotLevel.ResetKitVariants a full Randomize leaves its gear and spells in the cache, world thread only
+static BotResetKitCache g_ResetKits;
+
+static BotResetKit CaptureResetKit(Player* player)
+{
+    BotResetKit kit;
+    for (uint8 slot = EQUIPMENT_SLOT_START; slot < EQUIPMENT_SLOT_END; ++slot)
+        if (Item* item = player->GetItemByPos(INVENTORY_SLOT_BAG_0, slot))
+            kit.items[slot] = item->GetEntry();
+
+    // Talents are picked for each bot, the spells they teach come with the talent tree's kits
+    for (auto const& [spellId, spell] : player->GetSpellMap())
+        if (spell->State != PLAYERSPELL_REMOVED && !GetTalentSpellCost(spellId))
+            kit.spells.push_back(spellId);
+    return kit;
+}
+
+// Levels the bot like .character level does and lets the factory pick its talents, which decide the kit. The
+// kit's spells replace the bot's and its equipment is equipped new. Bags, consumables, quests and reputation
+// are kept. Returns false, with the bot levelled but not equipped, when the talent tree has no kits yet.
+static bool ApplyResetKit(Player* player, uint8 level)
+{
+    player->GiveLevel(level);
+    player->SetUInt32Value(PLAYER_XP, 0);
+    PlayerbotFactory factory(player, level);
+    factory.InitTalentsTree(false, true, true);
+
+    BotResetKit const* kit = g_ResetKits.Find(player->getRace(), player->getClass(), AiFactory::GetPlayerSpecTab(player), level,
+                                              player->GetGUID().GetCounter());
+    if (!kit)
+        return false;
+
+    std::vector<uint32> unlearn;
+    for (auto const& [spellId, spell] : player->GetSpellMap())
+        if (spell->State != PLAYERSPELL_REMOVED && !GetTalentSpellCost(spellId) && !std::binary_search(kit->spells.begin(), kit->spells.end(), spellId))
+            unlearn.push_back(spellId);
+    for (uint32 spellId : unlearn)
+        player->removeSpell(spellId, SPEC_MASK_ALL, false);
+    for (uint32 spellId : kit->spells)
+        if (!player->HasSpell(spellId))
+            player->learnSpell(spellId);
+
+    // Everything comes off first, a two-handed weapon cannot go on next to the old off-hand
+    for (uint8 slot = EQUIPMENT_SLOT_START; slot < EQUIPMENT_SLOT_END; ++slot)
+        player->DestroyItem(INVENTORY_SLOT_BAG_0, slot, true);
+    for (uint8 slot = EQUIPMENT_SLOT_START; slot < EQUIPMENT_SLOT_END; ++slot)
+    {
+        uint16 dest;
+        if (kit->items[slot] && player->CanEquipNewItem(slot, dest, kit->items[slot], false) == EQUIP_ERR_OK)
+            player->EquipNewItem(dest, kit->items[slot], true);
+    }
+    return true;
+}
+
+static bool RandomizeBot(Player* player, uint8 level)
+{
+    ObjectGuid::LowType guid = player->GetGUID().GetCounter();
+    ObjectGuid::LowType running = 0;
+    if (!g_RandomizingBot.compare_exchange_strong(running, guid))
+    {
+        LOG_ERROR("server.loading", "[mod-player-bot-reset] Bot {} was not randomized, bot {} is still being randomized.", guid, running);
+        return false;
+    }
+
+    uint8 const race = player->getRace();
+    uint8 const playerClass = player->getClass();
+    bool kitApplied = false;
+    if (g_ResetKits.HasKits(race, playerClass, level))
+    {
+        ScopedLatency timer(g_Stats.resetKit);
+        kitApplied = ApplyResetKit(player, level);
+    }
+
+    if (!kitApplied)
     {
-        uint32 guildId = result->Fetch()->Get<uint32>();
-        g_PersistentRealPlayerGuildIds.insert(guildId);
-        if (g_DebugMode)
         {
-            LOG_INFO("server.loading", "[mod-player-bot-reset] Loaded guild {} as having real players.", guildId);
+            ScopedLatency timer(g_Stats.randomize);
+            ScopedLatency classTimer(g_Stats.randomizeByClass[playerClass < MAX_CLASSES ? playerClass : uint8(CLASS_NONE)]);
+            PlayerbotFactory newFactory(player, level);
+            newFactory.Randomize(false);
         }
-    } while (result->NextRow());
+        if (g_ResetKits.IsEnabled())
+            g_ResetKits.Add(race, playerClass, AiFactory::GetPlayerSpecTab(player), level, CaptureResetKit(player));
+    }
+    g_RandomizingBot.store(0);
+    SetBotEligibilityLevel(guid, player->GetLevel());
+    RefreshRandomBotRecord(player, true);
+    return true;
+}
 
-    if (g_DebugMode)
+// -----------------------------------------------------------------------------
+// HELPER FUNCTION: Perform the Reset Actions for a Bot
+// -----------------------------------------------------------------------------
+// levelToResetTo comes from the compiled policy table and already respects the class start level
+static bool ResetBot(Player* player, uint8 currentLevel, uint8 levelToResetTo, PlayerBotResetConfig const& config)
+{
+    // Dismount before randomization to prevent wrong mount at new level
+    if (player->IsMounted())
+    {
+        player->Dismount();
+    }
+
+    if (!RandomizeBot(player, levelToResetTo))
+        return false;
+    CountLevelChange(false, currentLevel, player->getClass());
+
+    if (config.debugMode)
+    {
+        LogBotResetEvent(config, BOT_RESET_LOG_RESET, player, { player->getClass(), currentLevel, levelToResetTo });
+    }
+
+    ChatHandler(player->GetSession()).SendSysMessage("[mod-player-bot-reset] Your level has been reset.");
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// HELPER FUNCTION: Perform the Skip Actions for a Bot
+// -----------------------------------------------------------------------------
+static bool SkipBotLevel(Player* player, uint8 currentLevel, uint8 levelToSkipTo, PlayerBotResetConfig const& config)
+{
+    // Dismount before randomization to prevent wrong mount at new level
+    if (player->IsMounted())
+    {
+        player->Dismount();
+    }
+
+    if (!RandomizeBot(player, levelToSkipTo))
+        return false;
+    CountLevelChange(true, currentLevel, player->getClass());
+
+    if (config.debugMode)
+    {
+        LogBotResetEvent(config, BOT_RESET_LOG_SKIP, player, { player->getClass(), currentLevel, levelToSkipTo });
+    }
+
+    ChatHandler(player->GetSession()).SendSysMessage("[mod-player-bot-reset] Your level has been adjusted.");
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// ADAPTIVE THROTTLE
+// Fed with every world update diff by ResetBotLevelWorldScript, which runs before the queue and the
+// time-played checks. Both back off while the average diff is above ResetBotLevel.ThrottleTargetDiff.
+// -----------------------------------------------------------------------------
+static AdaptiveWorkThrottle g_WorkThrottle;
+
+static char const* GetThrottleStateName(uint32 scale)
+{
+    if (scale <= AdaptiveWorkThrottle::SCALE_MIN)
+        return "at minimum";
+    if (scale < AdaptiveWorkThrottle::SCALE_NORMAL)
+        return "backing off";
+    if (scale > AdaptiveWorkThrottle::SCALE_NORMAL)
+        return "catching up";
+    return "normal";
+}
+
+static void UpdateWorkThrottle(uint32 diff, PlayerBotResetConfig const& config)
+{
+    char const* previousState = GetThrottleStateName(g_WorkThrottle.GetScale());
+    g_WorkThrottle.Update(diff, config.throttleTargetDiff);
+
+    if (config.debugMode && GetThrottleStateName(g_WorkThrottle.GetScale()) != previousState)
+    {
+        LogBotResetEvent(config, BOT_RESET_LOG_THROTTLE, nullptr, { g_WorkThrottle.GetScale(), g_WorkThrottle.GetAverageDiff(),
+                                                                    config.throttleTargetDiff });
+    }
+}
+
+// -----------------------------------------------------------------------------
+// RESET HISTORY AND COOLDOWN
+// Every reset and skip is buffered in a ring and written to bot_reset_history by a multi-row insert in
+// one asynchronous transaction every ResetBotLevel.HistoryFlushInterval seconds, or as soon as the ring
+// is full. The last reset time per bot is kept in memory for ResetBotLevel.ResetCooldown; the resets of
+// the last cooldown period are read back in one query at startup, or when a reload turns the cooldown on
+// or makes it longer, and queued resets wait for it. A reset decided during the cooldown is put off until
+// it runs out, see ProcessResetQueue().
+// -----------------------------------------------------------------------------
+static constexpr std::size_t RESET_HISTORY_RING_SIZE = 4096;
+static constexpr std::size_t RESET_HISTORY_BATCH_SIZE = 500;   // rows per INSERT statement
+
+struct BotResetHistoryRecord
+{
+    ObjectGuid::LowType guid;
+    uint32 time;       // unix time of the reset
+    uint8 fromLevel;
+    uint8 toLevel;
+    bool skip;
+    BotResetHook reason;
+};
+
+static BoundedRing<BotResetHistoryRecord> g_ResetHistory(RESET_HISTORY_RING_SIZE);
+static std::vector<BotResetHistoryRecord> g_ResetHistoryFlush;   // reused between flushes
+static std::unordered_map<ObjectGuid::LowType, uint32> g_LastResetTimes;
+static bool g_LastResetTimesLoaded = false;
+static QueryCallbackProcessor g_ResetHistoryCallbacks;
+
+static uint32 GetHistoryClock()
+{
+    return static_cast<uint32>(GameTime::GetGameTime().count());
+}
+
+// Queued resets are only held back by the cooldown, so without one nothing waits for the query
+static void LoadLastResetTimes(PlayerBotResetConfig const& config)
+{
+    g_LastResetTimesLoaded = false;
+    if (config.resetCooldown == 0)
+        return;
+
+    std::ostringstream query;
+    query << "SELECT guid, CAST(UNIX_TIMESTAMP(MAX(reset_time)) AS UNSIGNED) FROM bot_reset_history WHERE skipped = 0 AND reset_time >= FROM_UNIXTIME("
+          << GetHistoryClock() - std::min(GetHistoryClock(), config.resetCooldown) << ") GROUP BY guid";
+
+    g_ResetHistoryCallbacks.AddCallback(CharacterDatabase.AsyncQuery(query.str())
+        .WithCallback([](QueryResult result)
+    {
+        if (result)
+        {
+            do
+            {
+                Field* fields = result->Fetch();
+                // Resets since startup are newer than the stored ones
+                g_LastResetTimes.try_emplace(fields[0].Get<uint32>(), static_cast<uint32>(fields[1].Get<uint64>()));
+            } while (result->NextRow());
+        }
+        g_LastResetTimesLoaded = true;
+    }));
+}
+
+static void FlushBotResetHistory()
+{
+    if (g_ResetHistory.Empty())
+        return;
+
+    g_ResetHistoryFlush.clear();
+    g_ResetHistory.PopAll(g_ResetHistoryFlush);
+
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    for (std::size_t start = 0; start < g_ResetHistoryFlush.size(); start += RESET_HISTORY_BATCH_SIZE)
+    {
+        std::ostringstream query;
+        query << "INSERT INTO bot_reset_history (guid, from_level, to_level, skipped, reason, reset_time) VALUES ";
+        for (std::size_t i = start; i < std::min(g_ResetHistoryFlush.size(), start + RESET_HISTORY_BATCH_SIZE); ++i)
+        {
+            BotResetHistoryRecord const& record = g_ResetHistoryFlush[i];
+            query << (i > start ? "," : "") << '(' << record.guid << ',' << uint32(record.fromLevel) << ',' << uint32(record.toLevel) << ','
+                  << (record.skip ? 1 : 0) << ',' << uint32(record.reason) << ",FROM_UNIXTIME(" << record.time << "))";
+        }
+        trans->Append(query.str());
+    }
+    CharacterDatabase.CommitTransaction(trans);
+}
+
+static void RecordBotResetHistory(ObjectGuid::LowType guid, bool skip, BotResetHook reason, uint8 fromLevel, uint8 toLevel,
+    PlayerBotResetConfig const& config)
+{
+    uint32 now = GetHistoryClock();
+    if (!skip && config.resetCooldown > 0)
+        g_LastResetTimes[guid] = now;
+
+    if (!config.resetHistory)
+        return;
+
+    BotResetHistoryRecord record{ guid, now, fromLevel, toLevel, skip, reason };
+    if (!g_ResetHistory.Push(record))
+    {
+        FlushBotResetHistory();
+        g_ResetHistory.Push(record);
+    }
+}
+
+// Seconds left before the bot may be reset again, 0 when it may be reset now
+static uint32 GetBotResetCooldown(ObjectGuid::LowType guid, PlayerBotResetConfig const& config)
+{
+    auto itr = g_LastResetTimes.find(guid);
+    if (itr == g_LastResetTimes.end())
+        return 0;
+
+    uint32 elapsed = GetHistoryClock() - std::min(GetHistoryClock(), itr->second);
+    return elapsed < config.resetCooldown ? config.resetCooldown - elapsed : 0;
+}
+
+// Forgets the resets whose cooldown has run out
+static void PruneLastResetTimes(PlayerBotResetConfig const& config)
+{
+    uint32 now = GetHistoryClock();
+    for (auto itr = g_LastResetTimes.begin(); itr != g_LastResetTimes.end();)
+    {
+        if (config.resetCooldown == 0 || now - std::min(now, itr->second) >= config.resetCooldown)
+            itr = g_LastResetTimes.erase(itr);
+        else
+            ++itr;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// TIME-PLAYED DEADLINES
+// A bot at ResetBotLevel.MaxLevel becomes eligible exactly when its level played time reaches
+// ResetBotLevel.MinTimePlayed, so instead of polling every bot it is scheduled for that moment. A bot whose
+// reset was put off by ResetBotLevel.ResetCooldown is scheduled for the moment the cooldown runs out.
+// -----------------------------------------------------------------------------
+static BotDeadlineScheduler g_BotDeadlines;
+
+static uint64 GetDeadlineClock()
+{
+    return static_cast<uint64>(GameTime::GetGameTime().count());
+}
+
+static void ScheduleBotDeadline(ObjectGuid::LowType guid, uint32 delay)
+{
+    g_BotDeadlines.Schedule(guid, GetDeadlineClock() + delay);
+}
+
+// -----------------------------------------------------------------------------
+// DEFERRED RESET QUEUE
+// Randomize() re-gears, re-talents and re-learns spells, so the hooks only record their decision here.
+// The queue is drained by ResetBotQueueWorldScript under ResetBotLevel.ResetQueueTimeBudget per world tick, and
+// each bot is held back until it reaches a safe point. Randomize() picks and applies its gear, talents and
+// spells in one call that writes to the Player throughout, so it cannot be split into a plan built on a worker
+// thread and an apply step; it runs whole on the world thread, while no map is being updated.
+// -----------------------------------------------------------------------------
+enum class BotResetAction : uint8
+{
+    Reset,
+    Skip
+};
+
+struct PendingBotReset
+{
+    BotResetAction action;
+    BotResetHook hook;  // hook that made the decision, kept as the reason in the history
+    uint8 level;        // level the decision was made at
+    uint8 targetLevel;  // level the bot is sent to
+    uint32 queuedAt;  // getMSTime() when the bot was first queued
+};
+
+struct ResetQueueStats
+{
+    uint64 executed        = 0;
+    uint64 dropped         = 0;
+    uint64 cooldown        = 0;  // resets put off because the bot was reset too recently
+    uint32 lastLatencyMs   = 0;
+    uint32 maxLatencyMs    = 0;
+};
+
+static std::unordered_map<ObjectGuid::LowType, PendingBotReset> g_PendingResets;
+static std::deque<ObjectGuid::LowType> g_PendingResetOrder;
+static ResetQueueStats g_ResetQueueStats;
+
+static void QueueBotReset(Player* player, BotResetHook hook, BotResetAction action, uint8 currentLevel, uint8 targetLevel)
+{
+    ObjectGuid::LowType guid = player->GetGUID().GetCounter();
+    auto itr = g_PendingResets.find(guid);
+    if (itr != g_PendingResets.end())
     {
-        LOG_INFO("server.loading", "[mod-player-bot-reset] Loaded {} guilds with real players from persistent storage.", g_PersistentRealPlayerGuildIds.size());
+        // Already waiting: keep its place in the queue but act on the latest decision
+        itr->second.action = action;
+        itr->second.hook = hook;
+        itr->second.level = currentLevel;
+        itr->second.targetLevel = targetLevel;
+        return;
     }
+
+    g_PendingResets.emplace(guid, PendingBotReset{ action, hook, currentLevel, targetLevel, getMSTime() });
+    g_PendingResetOrder.push_back(guid);
 }
 
-static void UpdatePersistentGuildTracker()
+static void DropQueuedBotReset(ObjectGuid::LowType guid)
 {
-    if (g_DebugMode)
-    {
-        LOG_INFO("server.loading", "[mod-player-bot-reset] Starting persistent guild tracker update...");
-    }
+    // The order entry is discarded lazily by the drain loop
+    g_PendingResets.erase(guid);
+}
+
+static std::size_t GetResetQueueDepth()
+{
+    return g_PendingResets.size();
+}
 
-    // Find guilds with currently online real players
-    std::unordered_set<uint32> currentRealPlayerGuilds;
+// Randomize() must not run while the bot is fighting, inside an instance, grouped or between maps
+static bool IsBotAtSafePoint(Player* player)
+{
+    return !player->IsInCombat() &&
+           !player->GetGroup() &&
+           !player->IsBeingTeleported() &&
+           player->GetMap() && !player->GetMap()->Instanceable();
+}
+
+static void ProcessResetQueue(PlayerBotResetConfig const& config)
+{
+    if (g_PendingResetOrder.empty() || !g_WorkThrottle.HasTurn())
+        return;
 
-    const auto& allPlayers = ObjectAccessor::GetPlayers();
-    for (const auto& itr : allPlayers)
+    uint32 const budgetUs = g_WorkThrottle.ScaleLimit(config.resetQueueTimeBudgetUs);
+    auto const budgetStart = std::chrono::steady_clock::now();
+    // Each queued bot is looked at no more than once per tick, deferred bots go to the back
+    std::size_t remaining = g_PendingResetOrder.size();
+    uint32 processed = 0;
+    while (remaining-- > 0 && !g_PendingResetOrder.empty())
     {
-        Player* player = itr.second;
-        if (!player || !player->IsInWorld())
+        if (budgetUs > 0 && processed > 0 &&
+            std::chrono::steady_clock::now() - budgetStart >= std::chrono::microseconds(budgetUs))
+            break;
+
+        ObjectGuid::LowType guid = g_PendingResetOrder.front();
+        g_PendingResetOrder.pop_front();
+
+        auto itr = g_PendingResets.find(guid);
+        if (itr == g_PendingResets.end())
+            continue;
+
+        Player* player = ObjectAccessor::FindPlayer(ObjectGuid::Create<HighGuid::Player>(guid));
+        // A bot that delevelled in the meantime no longer matches the decision
+        if (!player || player->GetLevel() < itr->second.level)
+        {
+            ++g_ResetQueueStats.dropped;
+            g_PendingResets.erase(itr);
             continue;
+        }
 
-        if (!IsPlayerBot(player))
+        if (itr->second.action == BotResetAction::Reset && config.resetCooldown > 0)
         {
-            uint32 guildId = player->GetGuildId();
-            if (guildId != 0)
+            // The reset times of the previous run are still being read
+            if (!g_LastResetTimesLoaded)
+            {
+                g_PendingResetOrder.push_back(guid);
+                continue;
+            }
+
+            // The bot is looked at again by the time check once the cooldown has run out
+            if (uint32 cooldownLeft = GetBotResetCooldown(guid, config))
             {
-                currentRealPlayerGuilds.insert(guildId);
+                ++g_ResetQueueStats.cooldown;
+                if (config.debugMode)
+                    LogBotResetEvent(config, BOT_RESET_LOG_COOLDOWN, player, { player->GetLevel(), cooldownLeft });
+                g_PendingResets.erase(itr);
+                ScheduleBotDeadline(guid, cooldownLeft);
+                continue;
             }
         }
-    }
 
-    // Update or insert guilds with real players - ensure has_real_players is set to 1
-    for (uint32 guildId : currentRealPlayerGuilds)
-    {
-        CharacterDatabase.Execute(
-            "REPLACE INTO bot_reset_guild_tracker (guild_id, has_real_players) "
-            "VALUES ({}, 1)",
-            guildId
-        );
+        if (!IsBotAtSafePoint(player))
+        {
+            g_PendingResetOrder.push_back(guid);
+            continue;
+        }
+
+        PendingBotReset pending = itr->second;
+        g_PendingResets.erase(itr);
+
+        uint8 fromLevel = player->GetLevel();
+        bool done = pending.action == BotResetAction::Skip ? SkipBotLevel(player, fromLevel, pending.targetLevel, config)
+                                                           : ResetBot(player, fromLevel, pending.targetLevel, config);
+        if (!done)
+        {
+            ++g_ResetQueueStats.dropped;
+            continue;
+        }
+        RecordBotResetHistory(guid, pending.action == BotResetAction::Skip, pending.hook, fromLevel, player->GetLevel(), config);
 
-        // Add to our in-memory cache
-        g_PersistentRealPlayerGuildIds.insert(guildId);
+        uint32 latency = GetMSTimeDiffToNow(pending.queuedAt);
+        ++g_ResetQueueStats.executed;
+        g_ResetQueueStats.lastLatencyMs = latency;
+        g_ResetQueueStats.maxLatencyMs = std::max(g_ResetQueueStats.maxLatencyMs, latency);
+        ++processed;
     }
 
-    if (g_DebugMode)
+    if (config.debugMode && processed > 0)
     {
-        LOG_INFO("server.loading", "[mod-player-bot-reset] Persistent guild tracker update complete. {} total tracked guilds.",
-                 g_PersistentRealPlayerGuildIds.size());
+        LogBotResetEvent(config, BOT_RESET_LOG_QUEUE, nullptr, { processed, static_cast<uint32>(GetResetQueueDepth()),
+                                                        g_ResetQueueStats.lastLatencyMs, g_ResetQueueStats.maxLatencyMs });
     }
 }
 
 // -----------------------------------------------------------------------------
-// HELPER FUNCTION: Compute the Reset Chance
+// POLICY GLUE: Snapshot a Bot and Carry Out the Policy Decision
 // -----------------------------------------------------------------------------
-static uint8 ComputeResetChance(uint8 level)
+static BotSnapshot MakeBotSnapshot(Player* player, BotEligibility const* eligibility)
+{
+    BotSnapshot bot;
+    bot.guid = player->GetGUID().GetCounter();
+    bot.levelPlayedTime = player->GetLevelPlayedTime();
+    bot.totalPlayedTime = player->GetTotalPlayedTime();
+    bot.guildId = eligibility ? eligibility->guildId : player->GetGuildId();
+    bot.level = player->GetLevel();
+    bot.playerClass = player->getClass();
+    bot.flags = eligibility ? eligibility->flags : 0;
+    return bot;
+}
+
+// Counts and logs the decision, safe to call from any thread
+static void RecordBotResetDecision(Player* player, BotResetHook hook, BotResetDecision const& decision, PlayerBotResetConfig const& config)
 {
-    uint8 chance = g_ResetBotChancePercent;
-    if (g_ScaledChance)
+    CountHookFilter(hook, decision.filter);
+
+    if (config.debugMode && decision.filter != BOT_RESET_FILTER_LEVEL)
     {
-        chance = static_cast<uint8>((static_cast<float>(level) / g_ResetBotMaxLevel) * g_ResetBotChancePercent);
-        if (g_DebugMode)
-        {
-            LOG_INFO("server.loading", "[mod-player-bot-reset] ComputeResetChance: For level {} / {} with scaling, computed chance = {}%", level, g_ResetBotMaxLevel, chance);
-        }
+        LogBotResetEvent(config, BOT_RESET_LOG_DECISION, player, { hook, player->GetLevel(), static_cast<uint32>(decision.verdict),
+                                                          decision.filter, decision.deferSeconds });
     }
-    else if (g_DebugMode)
+}
+
+// Queues or schedules the bot, world thread only
+static void CarryOutBotResetDecision(Player* player, BotResetHook hook, BotResetDecision const& decision)
+{
+    switch (decision.verdict)
     {
-        LOG_INFO("server.loading", "[mod-player-bot-reset] ComputeResetChance: For level {} / {} without scaling, chance = {}%", level, g_ResetBotMaxLevel, chance);
+        case BotResetVerdict::Reset:
+            QueueBotReset(player, hook, BotResetAction::Reset, player->GetLevel(), decision.targetLevel);
+            break;
+        case BotResetVerdict::Skip:
+            QueueBotReset(player, hook, BotResetAction::Skip, player->GetLevel(), decision.targetLevel);
+            break;
+        case BotResetVerdict::Defer:
+            ScheduleBotDeadline(player->GetGUID().GetCounter(), decision.deferSeconds);
+            break;
+        case BotResetVerdict::None:
+            break;
     }
-    return chance;
 }
 
-// -----------------------------------------------------------------------------
-// HELPER FUNCTION: Perform the Reset Actions for a Bot
-// -----------------------------------------------------------------------------
-static void ResetBot(Player* player, uint8 currentLevel)
+static void ApplyBotResetDecision(Player* player, BotResetHook hook, BotResetDecision const& decision, PlayerBotResetConfig const& config)
 {
-    uint8 levelToResetTo = g_ResetToLevel;
-
-    // If the configured reset level is below 55 and this is a Death Knight, use 55 instead
-    if (player->getClass() == CLASS_DEATH_KNIGHT && g_ResetToLevel < 55)
-        levelToResetTo = 55;
+    RecordBotResetDecision(player, hook, decision, config);
+    CarryOutBotResetDecision(player, hook, decision);
+}
 
-    // Dismount before randomization to prevent wrong mount at new level
-    if (player->IsMounted())
+// Runs the login evaluation again for the online eligible bots after a reload, so a changed MaxLevel, skip
+// range or time-played setting applies to them right away and their time-played checks are rescheduled.
+// Bots at a level that only rolls are left for their next event, a reload does not hand out extra rolls.
+static void ReevaluateOnlineBots(PlayerBotResetConfig const& config)
+{
+    // Re-validating the random bot flag can take a bot off g_EligibleBots
+    std::vector<ObjectGuid::LowType> const bots = g_EligibleBots;
+    for (ObjectGuid::LowType guid : bots)
     {
-        player->Dismount();
-    }
-
-    PlayerbotFactory newFactory(player, levelToResetTo);
+        Player* player = ObjectAccessor::FindPlayer(ObjectGuid::Create<HighGuid::Player>(guid));
+        if (!player)
+            continue;
 
-    newFactory.Randomize(false);
+        RevalidateRandomBot(player);
 
-    if (g_DebugMode)
-    {
-        PlayerbotAI* botAI = sPlayerbotsMgr->GetPlayerbotAI(player);
-        std::string playerClassName = botAI ? botAI->GetChatHelper()->FormatClass(player->getClass()) : "Unknown";
-        LOG_INFO("server.loading", "[mod-player-bot-reset] ResetBot: Bot '{}' - {} at level {} was reset to level {}.",
-                 player->GetName(), playerClassName, currentLevel, levelToResetTo);
-    }
+        // A bot at a roll level keeps its scheduled check, which only a reset cooldown can have left
+        BotResetPolicyEntry const& entry = config.policy.GetEntry(player->GetLevel(), player->getClass());
+        if (entry.rule[static_cast<uint8>(BotResetTrigger::Login)] == BotResetPolicy::LEVEL_RULE_ROLL)
+            continue;
 
-    ChatHandler(player->GetSession()).SendSysMessage("[mod-player-bot-reset] Your level has been reset.");
+        g_BotDeadlines.Cancel(guid);
 
+        BotResetDecision decision = EvaluateBotReset(MakeBotSnapshot(player, &g_BotEligibility.find(guid)->second), BotResetTrigger::Login,
+                                                     config.policy, g_RealPlayerGuilds, g_LevelHistogram);
+        ApplyBotResetDecision(player, BOT_RESET_HOOK_LOGIN, decision, config);
+    }
 }
 
 // -----------------------------------------------------------------------------
-// HELPER FUNCTION: Perform the Skip Actions for a Bot
+// SHARED STATE
+// OnPlayerLevelChanged and the guild membership hooks may run on map update threads, while the guild
+// index, the eligibility cache, the reset queue and the deadlines belong to the world thread. The hooks
+// only post what happened to an inbox, drained by the world thread at the start of its next update.
+// A level change just marks the bot dirty: a bot that gained several levels since the last drain, from
+// a row of quest turn-ins or one large experience award, is evaluated once against its final level.
+// The configuration is published as a snapshot by LoadPlayerBotResetConfig.
 // -----------------------------------------------------------------------------
-static void SkipBotLevel(Player* player, uint8 currentLevel)
+enum class SharedStateCommandType : uint8
+{
+    LevelChanged,
+    GuildJoined,
+    GuildLeft,
+    GuildDisbanded
+};
+
+struct SharedStateCommand
 {
-    uint8 levelToSkipTo = g_SkipToLevel;
+    SharedStateCommandType type;
+    ObjectGuid::LowType guid;
+    uint32 guildId;
+    bool realPlayer;
+};
 
-    // If the configured skip level is below 55 and this is a Death Knight, use 55 instead
-    if (player->getClass() == CLASS_DEATH_KNIGHT && g_SkipToLevel < 55)
-        levelToSkipTo = 55;
+static std::mutex g_SharedStateInboxLock;
+static std::vector<SharedStateCommand> g_SharedStateInbox;
+static std::vector<SharedStateCommand> g_SharedStateDrain;   // world thread only, keeps its capacity between updates
+static std::vector<ObjectGuid::LowType> g_DirtyBots;         // world thread only, bots whose level changed
 
-    // Dismount before randomization to prevent wrong mount at new level
-    if (player->IsMounted())
+static void PostSharedStateCommand(SharedStateCommand const& command)
+{
+    std::lock_guard<std::mutex> guard(g_SharedStateInboxLock);
+    g_SharedStateInbox.push_back(command);
+}
+
+// Runs after the guild commands of the same drain, so the decision sees the bot's current guild
+static void EvaluateDirtyBots(PlayerBotResetConfig const& config)
+{
+    std::sort(g_DirtyBots.begin(), g_DirtyBots.end());
+    g_DirtyBots.erase(std::unique(g_DirtyBots.begin(), g_DirtyBots.end()), g_DirtyBots.end());
+
+    for (ObjectGuid::LowType guid : g_DirtyBots)
     {
-        player->Dismount();
+        // Any pending time-played check was for an earlier level
+        g_BotDeadlines.Cancel(guid);
+        Player* player = ObjectAccessor::FindConnectedPlayer(ObjectGuid::Create<HighGuid::Player>(guid));
+        if (!player)
+            continue;
+
+        SetBotEligibilityLevel(guid, player->GetLevel());
+        RevalidateRandomBot(player);
+        RefreshRandomBotRecord(player, true);
+        BotResetDecision decision = EvaluateBotReset(MakeBotSnapshot(player, GetBotEligibility(player)), BotResetTrigger::LevelChanged,
+                                                     config.policy, g_RealPlayerGuilds, g_LevelHistogram);
+        ApplyBotResetDecision(player, BOT_RESET_HOOK_LEVEL_CHANGED, decision, config);
     }
+    g_DirtyBots.clear();
+}
 
-    PlayerbotFactory newFactory(player, levelToSkipTo);
-    newFactory.Randomize(false);
+static void DrainSharedStateCommands()
+{
+    {
+        std::lock_guard<std::mutex> guard(g_SharedStateInboxLock);
+        g_SharedStateDrain.swap(g_SharedStateInbox);
+    }
 
-    if (g_DebugMode)
+    for (SharedStateCommand const& command : g_SharedStateDrain)
     {
-        PlayerbotAI* botAI = sPlayerbotsMgr->GetPlayerbotAI(player);
-        std::string playerClassName = botAI ? botAI->GetChatHelper()->FormatClass(player->getClass()) : "Unknown";
-        LOG_INFO("server.loading", "[mod-player-bot-reset] SkipBotLevel: Bot '{}' - {} at level {} was skipped to level {}.",
-                 player->GetName(), playerClassName, currentLevel, levelToSkipTo);
+        switch (command.type)
+        {
+            case SharedStateCommandType::LevelChanged:
+                g_DirtyBots.push_back(command.guid);
+                break;
+            case SharedStateCommandType::GuildJoined:
+                SetBotEligibilityGuild(command.guid, command.guildId);
+                SetRandomBotGuild(command.guid, command.guildId);
+                // Logout may have run in between, the player must not be counted again
+                if (command.realPlayer && ObjectAccessor::FindConnectedPlayer(ObjectGuid::Create<HighGuid::Player>(command.guid)))
+                    g_RealPlayerGuilds.AddOnlinePlayer(command.guid, command.guildId);
+                break;
+            case SharedStateCommandType::GuildLeft:
+                SetBotEligibilityGuild(command.guid, 0);
+                SetRandomBotGuild(command.guid, 0);
+                g_RealPlayerGuilds.RemoveOnlinePlayer(command.guid);
+                break;
+            case SharedStateCommandType::GuildDisbanded:
+                g_RealPlayerGuilds.RemoveGuild(command.guildId);
+                g_RandomBotRoster.ClearGuild(command.guildId);
+                CharacterDatabase.Execute("DELETE FROM bot_reset_guild_tracker WHERE guild_id = {}", command.guildId);
+                break;
+        }
     }
+    g_SharedStateDrain.clear();
 
-    ChatHandler(player->GetSession()).SendSysMessage("[mod-player-bot-reset] Your level has been adjusted.");
+    if (!g_DirtyBots.empty())
+        EvaluateDirtyBots(*GetConfig());
 }
 
 // -----------------------------------------------------------------------------
@@ -369,75 +1859,36 @@ public:
             return;
         }
 
-        if (!IsPlayerBot(player))
-        {
-            if (g_DebugMode)
-                LOG_INFO("server.loading", "[mod-player-bot-reset] OnPlayerLogin: Player '{}' is a real player. Skipping reset check.", player->GetName());
-            return;
-        }
-
-        if (!IsPlayerRandomBot(player))
+        if (IsRealPlayerSession(player))
         {
-            if (g_DebugMode)
-                LOG_INFO("server.loading", "[mod-player-bot-reset] OnPlayerLogin: Player '{}' is not a random bot. Skipping reset check.", player->GetName());
-            return;
+            g_RealPlayerGuilds.AddOnlinePlayer(player->GetGUID().GetCounter(), player->GetGuildId());
         }
 
-        // Check exclusions
-        if (IsBotExcluded(player))
+        PlayerBotResetConfigPtr config = GetConfig();
+        BotEligibility const& eligibility = BuildBotEligibility(player, *config);
+        if (eligibility.IsRandomBot())
+            StoreRandomBotRecord(g_RandomBotRoster.Upsert(player->GetGUID().GetCounter()), player, true);
+        BotResetDecision decision;
+        if (!TakePendingLoginDecision(player, eligibility, *config, decision))
         {
-            if (g_DebugMode)
-                LOG_INFO("server.loading", "[mod-player-bot-reset] OnPlayerLogin: Bot '{}' is in exclusion list. Skipping reset check.", player->GetName());
-            return;
+            decision = EvaluateBotReset(MakeBotSnapshot(player, &eligibility), BotResetTrigger::Login,
+                                        config->policy, g_RealPlayerGuilds, g_LevelHistogram);
         }
+        ApplyBotResetDecision(player, BOT_RESET_HOOK_LOGIN, decision, *config);
+    }
 
-        if (g_IgnoreGuildBotsWithRealPlayers && BotInGuildWithRealPlayer(player))
+    void OnPlayerLogout(Player* player) override
+    {
+        if (!player)
         {
-            if (g_DebugMode)
-                LOG_INFO("server.loading", "[mod-player-bot-reset] OnPlayerLogin: Bot '{}' is in guild with real players. Skipping reset check.", player->GetName());
             return;
         }
 
-        uint8 currentLevel = player->GetLevel();
-
-        // Check for MaxLevel condition
-        if (g_ResetBotMaxLevel > 0)
-        {
-            // Handle the case where bot is above MaxLevel - immediate reset
-            if (currentLevel > g_ResetBotMaxLevel)
-            {
-                if (g_DebugMode)
-                    LOG_INFO("server.loading", "[mod-player-bot-reset] OnPlayerLogin: Bot '{}' above max level {}. Resetting immediately.",
-                            player->GetName(), g_ResetBotMaxLevel);
-                ResetBot(player, currentLevel);
-                return;
-            }
-
-            // Handle bot at exactly MaxLevel - apply time-played restriction
-            if (currentLevel == g_ResetBotMaxLevel)
-            {
-                if (!g_RestrictResetByPlayedTime || player->GetLevelPlayedTime() >= g_MinTimePlayed)
-                {
-                    uint8 resetChance = ComputeResetChance(currentLevel);
-                    if (urand(0, 99) < resetChance)
-                    {
-                        if (g_DebugMode)
-                            LOG_INFO("server.loading", "[mod-player-bot-reset] OnPlayerLogin: Bot '{}' meets reset criteria. Resetting.",
-                                    player->GetName());
-                        ResetBot(player, currentLevel);
-                    }
-                }
-            }
-        }
-
-        // Check for SkipFromLevel condition
-        if (g_SkipFromLevel > 0 && currentLevel == g_SkipFromLevel)
-        {
-            if (g_DebugMode)
-                LOG_INFO("server.loading", "[mod-player-bot-reset] OnPlayerLogin: Bot '{}' at skip level {}. Applying skip.",
-                        player->GetName(), currentLevel);
-            SkipBotLevel(player, currentLevel);
-        }
+        g_RealPlayerGuilds.RemoveOnlinePlayer(player->GetGUID().GetCounter());
+        DropQueuedBotReset(player->GetGUID().GetCounter());
+        g_BotDeadlines.Cancel(player->GetGUID().GetCounter());
+        DropBotEligibility(player->GetGUID().GetCounter());
+        RefreshRandomBotRecord(player, false);
     }
 
     void OnPlayerLevelChanged(Player* player, uint8 /*oldLevel*/) override
@@ -448,190 +1899,251 @@ public:
             return;
         }
 
-        if (!IsPlayerBot(player))
-        {
-            if (g_DebugMode)
-                LOG_INFO("server.loading", "[mod-player-bot-reset] OnLevelChanged: Player '{}' is a real player. Skipping reset check.", player->GetName());
+        // The levels a reset or skip hands out are not evaluated again
+        ObjectGuid::LowType guid = player->GetGUID().GetCounter();
+        if (g_RandomizingBot.load() == guid)
             return;
-        }
 
-        if (!IsPlayerRandomBot(player))
+        // May run on a map thread, the bot is only marked dirty and evaluated by the world thread
+        g_Stats.levelChanges.fetch_add(1, std::memory_order_relaxed);
+        PostSharedStateCommand({ SharedStateCommandType::LevelChanged, guid, 0, false });
+    }
+};
+
+// -----------------------------------------------------------------------------
+// GUILD SCRIPT: Keep the Online Guild Index Current
+// -----------------------------------------------------------------------------
+class ResetBotGuildIndexGuildScript : public GuildScript
+{
+public:
+    ResetBotGuildIndexGuildScript() : GuildScript("ResetBotGuildIndexGuildScript") { }
+
+    void OnAddMember(Guild* guild, Player* player, uint8& /*plRank*/) override
+    {
+        if (!guild || !player)
         {
-            if (g_DebugMode)
-                LOG_INFO("server.loading", "[mod-player-bot-reset] OnLevelChanged: Player '{}' is not a random bot. Skipping reset check.", player->GetName());
             return;
         }
 
-        // Check exclusions
-        if (IsBotExcluded(player))
+        PostSharedStateCommand({ SharedStateCommandType::GuildJoined, player->GetGUID().GetCounter(), guild->GetId(),
+                                 IsRealPlayerSession(player) });
+    }
+
+    void OnRemoveMember(Guild* /*guild*/, Player* player, bool /*isDisbanding*/, bool /*isKicked*/) override
+    {
+        // Offline members are not part of the online index
+        if (!player)
         {
-            if (g_DebugMode)
-                LOG_INFO("server.loading", "[mod-player-bot-reset] OnLevelChanged: Bot '{}' is in exclusion list. Skipping reset check.", player->GetName());
             return;
         }
 
-        if (g_IgnoreGuildBotsWithRealPlayers && BotInGuildWithRealPlayer(player))
+        PostSharedStateCommand({ SharedStateCommandType::GuildLeft, player->GetGUID().GetCounter(), 0, false });
+    }
+
+    void OnDisband(Guild* guild) override
+    {
+        if (!guild)
         {
-            if (g_DebugMode)
-                LOG_INFO("server.loading", "[mod-player-bot-reset] OnLevelChanged: Bot '{}' is in guild with real players. Skipping reset check.", player->GetName());
             return;
         }
 
-        uint8 newLevel = player->GetLevel();
-        if (newLevel == 1)
-            return;
+        PostSharedStateCommand({ SharedStateCommandType::GuildDisbanded, 0, guild->GetId(), false });
+    }
+};
+
+// -----------------------------------------------------------------------------
+// WORLD SCRIPT: Load Configuration on Startup and on .reload config
+// -----------------------------------------------------------------------------
+class ResetBotLevelWorldScript : public WorldScript
+{
+public:
+    ResetBotLevelWorldScript() : WorldScript("ResetBotLevelWorldScript") { }
+
+    void OnUpdate(uint32 diff) override
+    {
+        g_RandomBotRosterCallbacks.ProcessReadyCallbacks();
+        DrainSharedStateCommands();
+        UpdateWorkThrottle(diff, *GetConfig());
+    }
 
-        // Special case for Death Knights.
-        if (newLevel == 55 && player->getClass() == CLASS_DEATH_KNIGHT)
+    void OnAfterConfigLoad(bool reload) override
+    {
+        uint32 const previousCooldown = GetConfig()->resetCooldown;
+        if (!LoadPlayerBotResetConfig(reload))
             return;
 
-        // Check for the SkipFromLevel condition - this takes priority and is not affected by other settings
-        if (g_SkipFromLevel > 0 && newLevel == g_SkipFromLevel)
+        PlayerBotResetConfigPtr config = GetConfig();
+        if (config->debugMode)
+            g_DebugLog.Start();
+        g_ResetKits.SetVariants(config->resetKitVariants);
+
+        // Online players keep their eligibility record, so apply new exclusions and debug sampling to it.
+        // Pending login decisions and scheduled time-played checks were made under the previous policy.
+        if (reload)
         {
-            if (g_DebugMode)
-                LOG_INFO("server.loading", "[mod-player-bot-reset] OnLevelChanged: Bot '{}' reached skip level {}. Skipping to level {}.",
-                         player->GetName(), newLevel, g_SkipToLevel);
-            SkipBotLevel(player, newLevel);
-            return;
+            // Resets older than the previous cooldown were not kept in memory, read them back. The buffered
+            // history is written first so the query sees the resets made since the last flush.
+            if (config->resetCooldown > previousCooldown)
+            {
+                FlushBotResetHistory();
+                LoadLastResetTimes(*config);
+            }
+            RefreshBotEligibility(*config);
+            g_PendingLoginDecisions.clear();
+            ReevaluateOnlineBots(*config);
         }
+    }
+
+    void OnStartup() override
+    {
+        LoadPersistentGuildTracker();
+        LoadRandomBotRoster();
+
+        PlayerBotResetConfigPtr config = GetConfig();
+        LoadLastResetTimes(*config);
+        if (config->ignoreGuildBotsWithRealPlayers && config->guildReconcile)
+            StartGuildReconciliation();
+    }
+
+    void OnShutdown() override
+    {
+        // Writes out whatever is still buffered
+        FlushBotResetHistory();
+        g_DebugLog.Stop();
+    }
+};
 
-        // If MaxLevel is disabled (0), skip the reset logic
-        if (g_ResetBotMaxLevel == 0)
+// -----------------------------------------------------------------------------
+// WORLD SCRIPT: OnUpdate Check for Time-Played Based Reset at Max Level.
+// Bots at MaxLevel are scheduled for the moment they reach MinTimePlayed seconds at that level, and bots
+// held back by the reset cooldown for the moment it runs out (see TIME-PLAYED DEADLINES). This handler
+// collects the bots that are due, at most SweepBotsPerTick bots or SweepTimeBudget microseconds per world
+// tick, and runs the reset policy over them as one batch. With RestrictTimePlayed a bot that fails the roll
+// or is protected by its guild is checked again PlayedTimeCheckFrequency seconds later.
+// -----------------------------------------------------------------------------
+class ResetBotLevelTimeCheckWorldScript : public WorldScript
+{
+public:
+    ResetBotLevelTimeCheckWorldScript() : WorldScript("ResetBotLevelTimeCheckWorldScript") { }
+
+    void OnUpdate(uint32 /*diff*/) override
+    {
+        // Skip if MaxLevel is disabled, without time restrictions only cooldown checks are scheduled
+        PlayerBotResetConfigPtr config = GetConfig();
+        if (config->maxLevel == 0 || g_BotDeadlines.Size() == 0 || !g_WorkThrottle.HasTurn())
             return;
 
-        // If the bot is strictly above MaxLevel, reset immediately regardless of time played
-        if (g_ResetBotMaxLevel > 0 && newLevel > g_ResetBotMaxLevel)
+        uint32 const botsPerTick = g_WorkThrottle.ScaleLimit(config->sweepBotsPerTick);
+        uint32 const budgetUs = g_WorkThrottle.ScaleLimit(config->sweepTimeBudgetUs);
+        uint64 now = GetDeadlineClock();
+        auto const budgetStart = std::chrono::steady_clock::now();
+        ObjectGuid::LowType guid;
+        m_candidates.clear();
+        m_batch.Clear();
+        while (true)
         {
-            if (g_DebugMode)
-                LOG_INFO("server.loading", "[mod-player-bot-reset] OnLevelChanged: Bot '{}' exceeded max level {}. Resetting immediately.",
-                        player->GetName(), g_ResetBotMaxLevel);
+            if (botsPerTick > 0 && m_candidates.size() >= botsPerTick)
+                break;
+            if (budgetUs > 0 && !m_candidates.empty() &&
+                std::chrono::steady_clock::now() - budgetStart >= std::chrono::microseconds(budgetUs))
+                break;
+            if (!g_BotDeadlines.PopDue(now, guid))
+                break;
+
+            // Bots that logged out are no longer scheduled, this only guards against a stale entry
+            Player* candidate = ObjectAccessor::FindPlayer(ObjectGuid::Create<HighGuid::Player>(guid));
+            if (!candidate || !candidate->IsInWorld())
+                continue;
 
-            ResetBot(player, newLevel);
-            return;
+            // The bot may have been turned into an alt meanwhile
+            RevalidateRandomBot(candidate);
+            m_candidates.push_back(candidate);
+            m_batch.Add(MakeBotSnapshot(candidate, GetBotEligibility(candidate)));
         }
 
-        // If bot is exactly at MaxLevel, apply the regular time-played restriction
-        if (g_RestrictResetByPlayedTime && newLevel == g_ResetBotMaxLevel)
-        {
-            if (g_DebugMode)
-                LOG_INFO("server.loading", "[mod-player-bot-reset] OnLevelChanged: Bot '{}' at level {} deferred to OnUpdate due to time-played restriction.", player->GetName(), newLevel);
+        if (m_candidates.empty())
             return;
-        }
 
-        uint8 resetChance = ComputeResetChance(newLevel);
-        if (g_ScaledChance || newLevel >= g_ResetBotMaxLevel)
-        {
-            if (g_DebugMode)
-                LOG_INFO("server.loading", "[mod-player-bot-reset] OnLevelChanged: Bot '{}' at level {} has reset chance {}%.", player->GetName(), newLevel, resetChance);
-            if (urand(0, 99) < resetChance)
-                ResetBot(player, newLevel);
-        }
+        EvaluateBotResetBatch(m_batch, BotResetTrigger::TimeCheck, config->policy, g_RealPlayerGuilds, g_LevelHistogram, m_decisions);
+        for (std::size_t i = 0; i < m_candidates.size(); ++i)
+            ApplyBotResetDecision(m_candidates[i], BOT_RESET_HOOK_TIME_CHECK, m_decisions[i], *config);
+
+        g_Stats.timeCheck.Record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - budgetStart).count());
     }
+
+private:
+    std::vector<Player*> m_candidates;
+    BotSnapshotBatch m_batch;
+    std::vector<BotResetDecision> m_decisions;
 };
 
 // -----------------------------------------------------------------------------
-// WORLD SCRIPT: Load Configuration on Startup
+// WORLD SCRIPT: Drain the Deferred Reset Queue
 // -----------------------------------------------------------------------------
-class ResetBotLevelWorldScript : public WorldScript
+class ResetBotQueueWorldScript : public WorldScript
 {
 public:
-    ResetBotLevelWorldScript() : WorldScript("ResetBotLevelWorldScript") { }
+    ResetBotQueueWorldScript() : WorldScript("ResetBotQueueWorldScript") { }
 
-    void OnStartup() override
+    void OnUpdate(uint32 /*diff*/) override
     {
-        LoadPlayerBotResetConfig();
-        LoadPersistentGuildTracker();
-        LOG_INFO("server.loading", "[mod-player-bot-reset] Loaded and active with MaxLevel = {} ({}), ResetToLevel = {}, SkipFromLevel = {} ({}), SkipToLevel = {}, ResetChance = {}%, ScaledChance = {}, IgnoreGuildBotsWithRealPlayers = {}, ExcludedNames = {}.",
-                 static_cast<int>(g_ResetBotMaxLevel),
-                 g_ResetBotMaxLevel > 0 ? "Enabled" : "Disabled",
-                 static_cast<int>(g_ResetToLevel),
-                 static_cast<int>(g_SkipFromLevel),
-                 g_SkipFromLevel > 0 ? "Enabled" : "Disabled",
-                 static_cast<int>(g_SkipToLevel),
-                 static_cast<int>(g_ResetBotChancePercent),
-                 g_ScaledChance ? "Enabled" : "Disabled",
-                 g_IgnoreGuildBotsWithRealPlayers ? "Enabled" : "Disabled",
-                 g_ExcludeBotNames.empty() ? "None" : std::to_string(g_ExcludeBotNames.size()) + " names");
+        ProcessResetQueue(*GetConfig());
     }
 };
 
 // -----------------------------------------------------------------------------
-// WORLD SCRIPT: OnUpdate Check for Time-Played Based Reset at Max Level.
-// This handler runs every g_PlayedTimeCheckFrequency seconds and iterates over players.
-// For each bot at or above g_ResetBotMaxLevel that has accumulated at least g_MinTimePlayed
-// seconds at the current level, it applies the same reset chance logic and resets the bot if the check passes.
+// WORLD SCRIPT: Flush the Reset History
 // -----------------------------------------------------------------------------
-class ResetBotLevelTimeCheckWorldScript : public WorldScript
+class ResetBotHistoryWorldScript : public WorldScript
 {
 public:
-    ResetBotLevelTimeCheckWorldScript() : WorldScript("ResetBotLevelTimeCheckWorldScript"), m_timer(0) { }
+    ResetBotHistoryWorldScript() : WorldScript("ResetBotHistoryWorldScript"), m_timer(0) { }
 
     void OnUpdate(uint32 diff) override
     {
-        // Skip if time restrictions are disabled or MaxLevel is disabled
-        if (!g_RestrictResetByPlayedTime || g_ResetBotMaxLevel == 0)
-            return;
+        g_ResetHistoryCallbacks.ProcessReadyCallbacks();
 
+        PlayerBotResetConfigPtr config = GetConfig();
         m_timer += diff;
-        if (m_timer < g_PlayedTimeCheckFrequency * 1000)
+        if (m_timer < uint64(config->historyFlushInterval) * 1000)
             return;
         m_timer = 0;
 
-        if (g_DebugMode)
-        {
-            LOG_INFO("server.loading", "[mod-player-bot-reset] OnUpdate: Starting time-based reset check...");
-        }
-
-        auto const& allPlayers = ObjectAccessor::GetPlayers();
-        for (auto const& itr : allPlayers)
-        {
-            Player* candidate = itr.second;
-            if (!candidate || !candidate->IsInWorld())
-                continue;
-            if (!IsPlayerBot(candidate) || !IsPlayerRandomBot(candidate))
-                continue;
+        FlushBotResetHistory();
+        PruneLastResetTimes(*config);
+    }
 
-            // Check exclusions
-            if (IsBotExcluded(candidate))
-                continue;
+private:
+    uint64 m_timer;
+};
 
-            if (g_IgnoreGuildBotsWithRealPlayers && BotInGuildWithRealPlayer(candidate))
-                continue;
+// -----------------------------------------------------------------------------
+// WORLD SCRIPT: Scan Offline Bots for Pending Resets
+// -----------------------------------------------------------------------------
+class ResetBotPendingScanWorldScript : public WorldScript
+{
+public:
+    ResetBotPendingScanWorldScript() : WorldScript("ResetBotPendingScanWorldScript"), m_timer(0), m_started(false) { }
 
-            uint8 currentLevel = candidate->GetLevel();
-            if (currentLevel < g_ResetBotMaxLevel)
-                continue;
+    void OnUpdate(uint32 diff) override
+    {
+        PlayerBotResetConfigPtr config = GetConfig();
+        if (config->pendingResetScanInterval == 0 || !g_RandomBotRoster.IsLoaded())
+            return;
 
-            // Only reset if the bot has played at least g_MinTimePlayed seconds at this level.
-            if (candidate->GetLevelPlayedTime() < g_MinTimePlayed)
-            {
-                if (g_DebugMode)
-                {
-                    LOG_INFO("server.loading", "[mod-player-bot-reset] OnUpdate: Bot '{}' at level {} has insufficient played time ({} < {} seconds).",
-                             candidate->GetName(), currentLevel, candidate->GetLevelPlayedTime(), g_MinTimePlayed);
-                }
-                continue;
-            }
+        // The first scan runs as soon as the roster is loaded
+        m_timer += diff;
+        if (m_started && m_timer < uint64(config->pendingResetScanInterval) * 1000)
+            return;
+        m_timer = 0;
+        m_started = true;
 
-            uint8 resetChance = ComputeResetChance(currentLevel);
-            if (g_DebugMode)
-            {
-                LOG_INFO("server.loading", "[mod-player-bot-reset] OnUpdate: Bot '{}' qualifies for time-based reset. Level: {}, LevelPlayedTime: {} seconds, computed reset chance: {}%.",
-                         candidate->GetName(), currentLevel, candidate->GetLevelPlayedTime(), resetChance);
-            }
-            if (urand(0, 99) < resetChance)
-            {
-                if (g_DebugMode)
-                {
-                    LOG_INFO("server.loading", "[mod-player-bot-reset] OnUpdate: Reset chance check passed for bot '{}'. Resetting bot.", candidate->GetName());
-                }
-                ResetBot(candidate, currentLevel);
-            }
-        }
+        ScanPendingLoginDecisions(*config);
     }
 
 private:
-    uint32 m_timer;
+    uint64 m_timer;
+    bool m_started;
 };
 
 // -----------------------------------------------------------------------------
@@ -640,25 +2152,156 @@ private:
 class ResetBotGuildTrackerWorldScript : public WorldScript
 {
 public:
-    ResetBotGuildTrackerWorldScript() : WorldScript("ResetBotGuildTrackerWorldScript"), m_timer(0) { }
+    ResetBotGuildTrackerWorldScript() : WorldScript("ResetBotGuildTrackerWorldScript"), m_timer(0), m_reconcileTimer(0) { }
 
     void OnUpdate(uint32 diff) override
     {
+        g_GuildTrackerCallbacks.ProcessReadyCallbacks();
+
         // Only update if guild checking is enabled
-        if (!g_IgnoreGuildBotsWithRealPlayers)
+        PlayerBotResetConfigPtr config = GetConfig();
+        if (!config->ignoreGuildBotsWithRealPlayers)
             return;
 
+        // The startup reconciliation is started by ResetBotLevelWorldScript::OnStartup
+        if (config->guildReconcile && config->guildReconcileInterval > 0)
+        {
+            m_reconcileTimer += diff;
+            if (m_reconcileTimer >= uint64(config->guildReconcileInterval) * 1000)
+            {
+                m_reconcileTimer = 0;
+                StartGuildReconciliation();
+            }
+        }
+
         m_timer += diff;
-        // Update every 10 minutes (600 seconds)
-        if (m_timer < 600 * 1000)
+        if (m_timer < uint64(config->guildTrackerFlushInterval) * 1000)
             return;
         m_timer = 0;
 
-        UpdatePersistentGuildTracker();
+        UpdatePersistentGuildTracker(*config);
+    }
+
+private:
+    uint64 m_timer;
+    uint64 m_reconcileTimer;
+};
+
+// -----------------------------------------------------------------------------
+// COMMAND SCRIPT: .botreset stats [reset]
+// -----------------------------------------------------------------------------
+using namespace Acore::ChatCommands;
+
+class ResetBotCommandScript : public CommandScript
+{
+public:
+    ResetBotCommandScript() : CommandScript("ResetBotCommandScript") { }
+
+    ChatCommandTable GetCommands() const override
+    {
+        static ChatCommandTable statsCommandTable =
+        {
+            { "reset", HandleStatsResetCommand, SEC_ADMINISTRATOR, Console::Yes },
+            { "",      HandleStatsCommand,      SEC_GAMEMASTER,    Console::Yes }
+        };
+
+        static ChatCommandTable botResetCommandTable =
+        {
+            { "stats", statsCommandTable }
+        };
+
+        static ChatCommandTable commandTable =
+        {
+            { "botreset", botResetCommandTable }
+        };
+
+        return commandTable;
+    }
+
+    static bool HandleStatsCommand(ChatHandler* handler)
+    {
+        handler->SendSysMessage("[mod-player-bot-reset] Filter stage that decided each evaluation:");
+        for (uint8 hook = 0; hook < MAX_BOT_RESET_HOOK; ++hook)
+        {
+            std::ostringstream line;
+            for (uint8 filter = 0; filter < MAX_BOT_RESET_FILTER; ++filter)
+                line << (filter ? ", " : "") << BotResetFilterNames[filter] << '=' << g_Stats.hookFilters[hook][filter].load(std::memory_order_relaxed);
+            handler->PSendSysMessage("  {}: {}", BotResetHookNames[hook], line.str());
+        }
+
+        uint64 levelChangeEvaluations = 0;
+        for (auto const& counter : g_Stats.hookFilters[BOT_RESET_HOOK_LEVEL_CHANGED])
+            levelChangeEvaluations += counter.load(std::memory_order_relaxed);
+        handler->PSendSysMessage("Level changes: {} events evaluated as {} final levels.",
+            g_Stats.levelChanges.load(std::memory_order_relaxed), levelChangeEvaluations);
+
+        handler->PSendSysMessage("Reset queue: {} queued, {} executed, {} dropped, {} put off by the cooldown, last latency {} ms, max latency {} ms.",
+            GetResetQueueDepth(), g_ResetQueueStats.executed, g_ResetQueueStats.dropped, g_ResetQueueStats.cooldown,
+            g_ResetQueueStats.lastLatencyMs, g_ResetQueueStats.maxLatencyMs);
+        handler->PSendSysMessage("Reset throttle: {} at {}% of the configured work, average update diff {} ms, target {} ms.",
+            GetThrottleStateName(g_WorkThrottle.GetScale()), g_WorkThrottle.GetScale(), g_WorkThrottle.GetAverageDiff(),
+            GetConfig()->throttleTargetDiff);
+        handler->PSendSysMessage("Random bot roster: {} characters{}.", g_RandomBotRoster.Size(),
+            g_RandomBotRoster.IsLoaded() ? "" : ", still loading");
+        handler->PSendSysMessage("Online eligible bots: {}, scheduled time-played checks: {}, guilds with online real players: {}, tracked guilds: {}.",
+            g_EligibleBots.size(), g_BotDeadlines.Size(), g_RealPlayerGuilds.GetOnlineGuildCount(), g_RealPlayerGuilds.GetTrackedGuildCount());
+
+        SendLatency(handler, "Randomize", g_Stats.randomize);
+        for (uint8 playerClass = 0; playerClass < MAX_CLASSES; ++playerClass)
+        {
+            if (g_Stats.randomizeByClass[playerClass].Count() > 0)
+                SendLatency(handler, ("  " + std::string(BotResetClassNames[playerClass])).c_str(), g_Stats.randomizeByClass[playerClass]);
+        }
+        handler->PSendSysMessage("Reset kits: {} cached.", g_ResetKits.Size());
+        SendLatency(handler, "Reset kit", g_Stats.resetKit);
+        SendLatency(handler, "Time check pass", g_Stats.timeCheck);
+        SendLatency(handler, "Guild tracker flush", g_Stats.guildTrackerFlush);
+
+        SendLevelCounts(handler, GetConfig()->policy.distribution.IsActive() ? "Online eligible bots by level (steered)" : "Online eligible bots by level",
+                        g_LevelHistogram.Counts());
+        SendLevelCounts(handler, "Resets by level", g_Stats.resetsByLevel);
+        SendLevelCounts(handler, "Skips by level", g_Stats.skipsByLevel);
+
+        for (bool skip : { false, true })
+        {
+            auto const& counters = skip ? g_Stats.skipsByClass : g_Stats.resetsByClass;
+            std::ostringstream line;
+            for (uint8 playerClass = 0; playerClass < MAX_CLASSES; ++playerClass)
+            {
+                if (uint64 count = counters[playerClass].load(std::memory_order_relaxed))
+                    line << ' ' << BotResetClassNames[playerClass] << '=' << count;
+            }
+            handler->PSendSysMessage("{} by class:{}", skip ? "Skips" : "Resets", line.str().empty() ? " none" : line.str());
+        }
+        return true;
+    }
+
+    static bool HandleStatsResetCommand(ChatHandler* handler)
+    {
+        g_Stats.Reset();
+        g_ResetQueueStats = ResetQueueStats();
+        handler->SendSysMessage("[mod-player-bot-reset] Statistics have been reset.");
+        return true;
     }
 
 private:
-    uint32 m_timer;
+    static void SendLatency(ChatHandler* handler, char const* name, LatencyHistogram const& histogram)
+    {
+        handler->PSendSysMessage("{}: {} samples, avg {} us, p50 < {} us, p99 < {} us, max {} us.", name,
+            histogram.Count(), histogram.Average(), histogram.Percentile(50), histogram.Percentile(99), histogram.Max());
+    }
+
+    template <typename T, std::size_t N>
+    static void SendLevelCounts(ChatHandler* handler, char const* name, std::array<std::atomic<T>, N> const& counters)
+    {
+        std::ostringstream line;
+        for (std::size_t level = 0; level < N; ++level)
+        {
+            if (T count = counters[level].load(std::memory_order_relaxed))
+                line << ' ' << level << '=' << count;
+        }
+        handler->PSendSysMessage("{}:{}", name, line.str().empty() ? " none" : line.str());
+    }
 };
 
 // -----------------------------------------------------------------------------
@@ -669,5 +2312,10 @@ void Addmod_player_bot_resetScripts()
     new ResetBotLevelWorldScript();
     new ResetBotLevelPlayerScript();
     new ResetBotLevelTimeCheckWorldScript();
+    new ResetBotQueueWorldScript();
+    new ResetBotHistoryWorldScript();
+    new ResetBotPendingScanWorldScript();
     new ResetBotGuildTrackerWorldScript();
+    new ResetBotGuildIndexGuildScript();
+    new ResetBotCommandScript();
 }
@@ -0,0 +1,146 @@
+// Decision-path benchmarks over synthetic populations of 1k, 10k and 50k bots. The numbers are printed
+// for comparison between changes; the run only fails if the batch and per-bot paths disagree.
+
+#include "mod-player-bot-reset-core.h"
+#include "synthetic_bots.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+    // Keeps the optimizer from dropping the benchmarked work
+    uint64 g_Sink = 0;
+
+    template<typename Work>
+    double NanosPerBot(std::size_t bots, Work&& work)
+    {
+        // Enough rounds for roughly a million bot evaluations per measurement
+        std::size_t const rounds = std::max<std::size_t>(1, 1000000 / bots);
+        work();  // warm up
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t round = 0; round < rounds; ++round)
+            work();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / double(rounds * bots);
+    }
+
+    BotResetPolicyConfig MakeConfig()
+    {
+        BotResetPolicyConfig config;
+        config.maxLevel = 80;
+        config.chancePercent = 50;
+        config.scaledChance = true;
+        config.restrictByPlayedTime = true;
+        config.ignoreGuildsWithRealPlayers = true;
+        config.skipRanges = { { 20, 25 }, { 58, 60 } };
+        config.Compile();
+        return config;
+    }
+
+    bool RunPopulation(std::size_t count)
+    {
+        uint32 const guildCount = static_cast<uint32>(count / 20);
+        std::vector<BotSnapshot> bots = MakeSyntheticBots(count, guildCount, count);
+        BotResetPolicyConfig const config = MakeConfig();
+
+        RealPlayerGuildIndex guilds;
+        std::vector<RealPlayerGuildIndex::StoredGuild> stored;
+        for (uint32 guildId = 1; guildId <= guildCount; guildId += 4)
+            stored.push_back({ guildId, 0 });
+        guilds.LoadStoredGuilds(stored);
+
+        LevelHistogram levels;
+        for (BotSnapshot const& bot : bots)
+            levels.Add(bot.level);
+
+        BotSnapshotBatch batch;
+        for (BotSnapshot const& bot : bots)
+            batch.Add(bot);
+
+        std::printf("%zu bots:\n", count);
+
+        bool consistent = true;
+        std::vector<BotResetDecision> decisions;
+        for (BotResetTrigger trigger : { BotResetTrigger::Login, BotResetTrigger::LevelChanged, BotResetTrigger::TimeCheck })
+        {
+            double single = NanosPerBot(count, [&]
+            {
+                for (BotSnapshot const& bot : bots)
+                    g_Sink += static_cast<uint8>(EvaluateBotReset(bot, trigger, config, guilds, levels).verdict);
+            });
+            double batched = NanosPerBot(count, [&]
+            {
+                EvaluateBotResetBatch(batch, trigger, config, guilds, levels, decisions);
+                g_Sink += decisions.size();
+            });
+
+            for (std::size_t i = 0; i < count && consistent; ++i)
+                consistent = decisions[i].verdict == EvaluateBotReset(bots[i], trigger, config, guilds, levels).verdict;
+
+            std::printf("  evaluate trigger %u: %7.1f ns/bot single, %7.1f ns/bot batch\n",
+                uint32(static_cast<uint8>(trigger)), single, batched);
+        }
+
+        std::printf("  guild lookup:       %7.1f ns/bot\n", NanosPerBot(count, [&]
+        {
+            for (BotSnapshot const& bot : bots)
+                g_Sink += guilds.HasRealPlayer(bot.guildId);
+        }));
+
+        std::printf("  deadlines:          %7.1f ns/bot (schedule, reschedule and pop)\n", NanosPerBot(count, [&]
+        {
+            BotDeadlineScheduler deadlines;
+            for (BotSnapshot const& bot : bots)
+                deadlines.Schedule(bot.guid, bot.levelPlayedTime);
+            for (BotSnapshot const& bot : bots)
+                if (bot.guid % 4 == 0)
+                    deadlines.Schedule(bot.guid, bot.levelPlayedTime + 60);
+            uint32 guid;
+            while (deadlines.PopDue(~uint64(0), guid))
+                g_Sink += guid;
+        }));
+
+        BotNameExclusions exclusions;
+        exclusions.Clear();
+        for (uint32 i = 0; i < 100; ++i)
+            exclusions.Add(i % 10 == 0 ? "Tank" + std::to_string(i) + "*" : "Keep" + std::to_string(i));
+        exclusions.Add("*heal?r");
+        std::vector<std::string> names;
+        names.reserve(count);
+        for (BotSnapshot const& bot : bots)
+            names.push_back((bot.guid % 3 ? "Bot" : "Tank") + std::to_string(bot.guid));
+        std::printf("  exclusion match:    %7.1f ns/bot\n", NanosPerBot(count, [&]
+        {
+            for (std::string const& name : names)
+                g_Sink += exclusions.Matches(name);
+        }));
+
+        std::vector<RandomBotRecord> rows;
+        rows.reserve(count);
+        for (BotSnapshot const& bot : bots)
+            rows.push_back(RandomBotRecord{ bot.guid, bot.guid / 50, bot.guildId, bot.levelPlayedTime, bot.totalPlayedTime, bot.level,
+                                                     bot.playerClass, false });
+        std::printf("  roster load:        %7.1f ns/bot (1000 row chunks)\n", NanosPerBot(count, [&]
+        {
+            RandomBotRoster roster;
+            for (std::size_t offset = 0; offset < rows.size(); offset += 1000)
+                roster.LoadRecords(std::vector<RandomBotRecord>(rows.begin() + offset, rows.begin() + std::min(offset + 1000, rows.size())));
+            g_Sink += roster.Size();
+        }));
+
+        return consistent;
+    }
+}
+
+int main()
+{
+    bool consistent = true;
+    for (std::size_t count : { 1000, 10000, 50000 })
+        consistent = RunPopulation(count) && consistent;
+
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(g_Sink));
+    if (!consistent)
+        std::printf("batch and per-bot evaluation disagree\n");
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,766 @@
+// Regression suite for the world-free decision path in mod-player-bot-reset-core.h
+
+#include "mod-player-bot-reset-core.h"
+#include "synthetic_bots.h"
+#include <cstdio>
+
+static uint32 g_Checks = 0;
+static uint32 g_Failures = 0;
+
+#define CHECK(condition) \
+    do \
+    { \
+        ++g_Checks; \
+        if (!(condition)) \
+        { \
+            ++g_Failures; \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+        } \
+    } while (0)
+
+static bool SameDecision(BotResetDecision const& left, BotResetDecision const& right)
+{
+    return left.verdict == right.verdict && left.filter == right.filter &&
+           left.deferSeconds == right.deferSeconds && left.targetLevel == right.targetLevel;
+}
+
+static uint8 GetRule(BotResetPolicyConfig const& config, uint8 level, uint8 playerClass, BotResetTrigger trigger)
+{
+    return config.GetEntry(level, playerClass).rule[static_cast<uint8>(trigger)];
+}
+
+// -----------------------------------------------------------------------------
+// EXCLUSION MATCHER
+// -----------------------------------------------------------------------------
+static void TestExclusions()
+{
+    BotNameExclusions exclusions;
+    exclusions.Clear();
+    CHECK(!exclusions.Matches("Alice"));
+
+    exclusions.Add("Alice");
+    exclusions.Add("Bot*");
+    exclusions.Add("*tank?");
+    exclusions.Add("\xC3\x89mile");  // Émile
+    exclusions.Add("");
+    CHECK(exclusions.Size() == 4);
+
+    CHECK(exclusions.Matches("alice"));
+    CHECK(exclusions.Matches("ALICE"));
+    CHECK(!exclusions.Matches("Alic"));
+    CHECK(!exclusions.Matches("Alicea"));
+    CHECK(exclusions.Matches("Bottom"));
+    CHECK(exclusions.Matches("bot"));
+    CHECK(!exclusions.Matches("Bo"));
+    CHECK(exclusions.Matches("Maintanks"));
+    CHECK(!exclusions.Matches("tank"));
+    CHECK(exclusions.Matches("\xC3\x89mile"));
+    CHECK(!exclusions.Matches("\xFF"));
+
+    exclusions.Clear();
+    CHECK(exclusions.Empty());
+    CHECK(!exclusions.Matches("Bottom"));
+}
+
+// -----------------------------------------------------------------------------
+// REAL PLAYER GUILD INDEX
+// -----------------------------------------------------------------------------
+static void TestGuildIndex()
+{
+    RealPlayerGuildIndex guilds;
+
+    // Every guild is protected until the stored set is loaded, guildless bots never are
+    CHECK(guilds.HasRealPlayer(5));
+    CHECK(!guilds.HasRealPlayer(0));
+
+    guilds.LoadStoredGuilds({ { 10, 100 }, { 3, 50 } });
+    CHECK(guilds.IsStoredLoaded());
+    CHECK(guilds.HasRealPlayer(3));
+    CHECK(guilds.HasRealPlayer(10));
+    CHECK(!guilds.HasRealPlayer(4));
+
+    // Online players are refcounted per guild and their guild is stored right away
+    guilds.AddOnlinePlayer(1, 4);
+    guilds.AddOnlinePlayer(2, 4);
+    CHECK(guilds.HasRealPlayer(4));
+    CHECK(guilds.GetOnlineGuildCount() == 1);
+    CHECK(guilds.GetTrackedGuildCount() == 3);
+    guilds.RemoveOnlinePlayer(1);
+    CHECK(guilds.GetOnlineGuildCount() == 1);
+    guilds.RemoveOnlinePlayer(2);
+    CHECK(guilds.GetOnlineGuildCount() == 0);
+    CHECK(guilds.HasRealPlayer(4));
+
+    // Switching guilds releases the old one
+    guilds.AddOnlinePlayer(1, 10);
+    guilds.AddOnlinePlayer(1, 3);
+    CHECK(guilds.GetOnlineGuildCount() == 1);
+    guilds.RemoveOnlinePlayer(1);
+
+    // Guild 3 was already stored and is not written again, so it expires with its old last seen time
+    std::vector<uint32> expired;
+    guilds.TakeExpiredGuilds(60, expired);
+    CHECK((expired == std::vector<uint32>{ 3 }));
+    CHECK(!guilds.HasRealPlayer(3));
+
+    // Only the guild new to the stored set is written
+    std::vector<uint32> touched;
+    guilds.TakeTouchedGuilds(200, 0, touched);
+    CHECK((touched == std::vector<uint32>{ 4 }));
+    touched.clear();
+    guilds.TakeTouchedGuilds(300, 0, touched);
+    CHECK(touched.empty());
+
+    // An online guild is rewritten once its row is older than the refresh cutoff, not on every flush
+    guilds.AddOnlinePlayer(5, 10);
+    guilds.TakeTouchedGuilds(400, 100, touched);
+    CHECK(touched.empty());
+    guilds.TakeTouchedGuilds(500, 101, touched);
+    CHECK((touched == std::vector<uint32>{ 10 }));
+    uint32 writes = 0;
+    for (uint32 now = 700; now <= 1600; now += 100)
+    {
+        touched.clear();
+        guilds.TakeTouchedGuilds(now, now - 250, touched);
+        writes += static_cast<uint32>(touched.size());
+    }
+    CHECK(writes == 3);
+    guilds.RemoveOnlinePlayer(5);
+
+    // A real player logging in and out between two flushes still refreshes a row that is due
+    guilds.AddOnlinePlayer(6, 4);
+    guilds.RemoveOnlinePlayer(6);
+    touched.clear();
+    guilds.TakeTouchedGuilds(1700, 1450, touched);
+    CHECK((touched == std::vector<uint32>{ 4 }));
+
+    // Online guilds never expire
+    guilds.AddOnlinePlayer(7, 8);
+    touched.clear();
+    guilds.TakeTouchedGuilds(1800, 0, touched);
+    CHECK((touched == std::vector<uint32>{ 8 }));
+    expired.clear();
+    guilds.TakeExpiredGuilds(5000, expired);
+    CHECK(expired.size() == 2);
+    CHECK(std::find(expired.begin(), expired.end(), 8u) == expired.end());
+    CHECK(guilds.HasRealPlayer(8));
+
+    // Reconciled guilds are written when they are new
+    guilds.AddReconciledGuilds({ 12, 8, 0 });
+    CHECK(guilds.HasRealPlayer(12));
+    CHECK(guilds.GetTrackedGuildCount() == 2);
+    touched.clear();
+    guilds.TakeTouchedGuilds(1900, 0, touched);
+    CHECK((touched == std::vector<uint32>{ 12 }));
+
+    // A late load keeps the newer last seen time of a guild touched meanwhile
+    guilds.LoadStoredGuilds({ { 8, 10 }, { 20, 10 } });
+    expired.clear();
+    guilds.RemoveOnlinePlayer(7);
+    guilds.TakeExpiredGuilds(300, expired);
+    CHECK((expired == std::vector<uint32>{ 20 }));
+
+    guilds.RemoveGuild(8);
+    CHECK(!guilds.HasRealPlayer(8));
+}
+
+// -----------------------------------------------------------------------------
+// DEADLINE SCHEDULER
+// -----------------------------------------------------------------------------
+static void TestDeadlines()
+{
+    BotDeadlineScheduler deadlines;
+    deadlines.Schedule(1, 100);
+    deadlines.Schedule(2, 50);
+    deadlines.Schedule(3, 75);
+    deadlines.Schedule(2, 200);  // reschedule, the entry at 50 goes stale
+    deadlines.Cancel(3);
+    CHECK(deadlines.Size() == 2);
+
+    uint32 guid = 0;
+    CHECK(!deadlines.PopDue(99, guid));
+    CHECK(deadlines.PopDue(150, guid) && guid == 1);
+    CHECK(!deadlines.PopDue(150, guid));
+    CHECK(deadlines.PopDue(200, guid) && guid == 2);
+    CHECK(deadlines.Size() == 0);
+    CHECK(!deadlines.PopDue(~uint64(0), guid));
+
+    // Same deadline for many bots, each comes up once
+    for (uint32 i = 1; i <= 1000; ++i)
+        deadlines.Schedule(i, 10);
+    uint32 popped = 0;
+    while (deadlines.PopDue(10, guid))
+        ++popped;
+    CHECK(popped == 1000);
+}
+
+// -----------------------------------------------------------------------------
+// POLICY TABLE
+// -----------------------------------------------------------------------------
+static void TestResetChance()
+{
+    CHECK(ComputeResetChance(40, 80, 50, true) == 25);
+    CHECK(ComputeResetChance(80, 80, 50, true) == 50);
+    CHECK(ComputeResetChance(90, 80, 50, true) == 50);
+    CHECK(ComputeResetChance(40, 80, 50, false) == 50);
+    CHECK(ComputeResetChance(40, 0, 50, true) == 50);
+}
+
+static void TestPolicyTable()
+{
+    using namespace BotResetPolicy;
+
+    BotResetPolicyConfig config;
+    config.maxLevel = 80;
+    config.skipRanges = { { 10, 20 }, { 20, 30 } };
+    config.classResetToLevel[CLASS_DRUID] = 15;
+    config.classChancePercent[CLASS_HUNTER] = 40;
+    config.Compile();
+
+    // Chained skip ranges collapse into their final destination
+    CHECK(GetRule(config, 10, CLASS_WARRIOR, BotResetTrigger::LevelChanged) == LEVEL_RULE_SKIP);
+    CHECK(GetRule(config, 10, CLASS_WARRIOR, BotResetTrigger::Login) == LEVEL_RULE_SKIP);
+    CHECK(config.GetEntry(10, CLASS_WARRIOR).targetLevel == 30);
+    CHECK(config.GetEntry(20, CLASS_WARRIOR).targetLevel == 30);
+    CHECK(GetRule(config, 30, CLASS_WARRIOR, BotResetTrigger::LevelChanged) == LEVEL_RULE_NONE);
+    CHECK(GetRule(config, 40, CLASS_WARRIOR, BotResetTrigger::LevelChanged) == LEVEL_RULE_NONE);
+
+    CHECK(GetRule(config, 80, CLASS_WARRIOR, BotResetTrigger::Login) == LEVEL_RULE_ROLL);
+    CHECK(GetRule(config, 80, CLASS_WARRIOR, BotResetTrigger::LevelChanged) == LEVEL_RULE_ROLL);
+    CHECK(config.GetEntry(80, CLASS_WARRIOR).chance == 100);
+
+    // Without the time restriction only bots held back by the reset cooldown are time-checked
+    CHECK(GetRule(config, 80, CLASS_WARRIOR, BotResetTrigger::TimeCheck) == LEVEL_RULE_ROLL);
+    CHECK(GetRule(config, 81, CLASS_WARRIOR, BotResetTrigger::TimeCheck) == LEVEL_RULE_RESET);
+    CHECK(GetRule(config, 40, CLASS_WARRIOR, BotResetTrigger::TimeCheck) == LEVEL_RULE_NONE);
+    CHECK(GetRule(config, 81, CLASS_WARRIOR, BotResetTrigger::Login) == LEVEL_RULE_RESET);
+    CHECK(config.GetEntry(81, CLASS_WARRIOR).targetLevel == 1);
+
+    // Per-class overrides
+    CHECK(config.GetEntry(80, CLASS_HUNTER).chance == 40);
+    CHECK(config.GetEntry(80, CLASS_DRUID).targetLevel == 15);
+    CHECK(GetRule(config, 15, CLASS_DRUID, BotResetTrigger::LevelChanged) == LEVEL_RULE_NONE);
+
+    // Death Knights never go below their start level
+    CHECK(config.GetEntry(80, CLASS_DEATH_KNIGHT).targetLevel == 55);
+    CHECK(config.GetEntry(10, CLASS_DEATH_KNIGHT).targetLevel == 55);
+    CHECK(GetRule(config, 55, CLASS_DEATH_KNIGHT, BotResetTrigger::LevelChanged) == LEVEL_RULE_NONE);
+
+    // Unknown classes use the CLASS_NONE column
+    CHECK(&config.GetEntry(80, 200) == &config.GetEntry(80, CLASS_NONE));
+
+    config.restrictByPlayedTime = true;
+    config.Compile();
+    CHECK(GetRule(config, 80, CLASS_WARRIOR, BotResetTrigger::Login) == LEVEL_RULE_WAIT_PLAYED);
+    CHECK(GetRule(config, 80, CLASS_WARRIOR, BotResetTrigger::TimeCheck) == LEVEL_RULE_WAIT_PLAYED);
+    CHECK(GetRule(config, 81, CLASS_WARRIOR, BotResetTrigger::TimeCheck) == LEVEL_RULE_WAIT_PLAYED);
+    CHECK(EvaluateLevelRule(config.GetEntry(80, CLASS_WARRIOR), config.minTimePlayed, BotResetTrigger::TimeCheck, config) == LEVEL_RULE_ROLL);
+    CHECK(EvaluateLevelRule(config.GetEntry(80, CLASS_WARRIOR), config.minTimePlayed - 1, BotResetTrigger::TimeCheck, config) == LEVEL_RULE_WAIT_PLAYED);
+
+    config.restrictByPlayedTime = false;
+    config.scaledChance = true;
+    config.Compile();
+    CHECK(GetRule(config, 40, CLASS_WARRIOR, BotResetTrigger::LevelChanged) == LEVEL_RULE_ROLL);
+    CHECK(config.GetEntry(40, CLASS_WARRIOR).chance == 50);
+    CHECK(config.GetEntry(40, CLASS_HUNTER).chance == 20);
+
+    // A bot levelling into the reset level or a skip destination by playing is evaluated like at any other level
+    config.scaledChance = false;
+    config.resetToLevel = 10;
+    config.skipRanges = { { 10, 20 } };
+    config.Compile();
+    CHECK(GetRule(config, 10, CLASS_WARRIOR, BotResetTrigger::LevelChanged) == LEVEL_RULE_SKIP);
+    CHECK(config.GetEntry(10, CLASS_WARRIOR).targetLevel == 20);
+    config.scaledChance = true;
+    config.Compile();
+    CHECK(GetRule(config, 20, CLASS_WARRIOR, BotResetTrigger::LevelChanged) == LEVEL_RULE_ROLL);
+    CHECK(GetRule(config, 55, CLASS_DEATH_KNIGHT, BotResetTrigger::LevelChanged) == LEVEL_RULE_ROLL);
+}
+
+// -----------------------------------------------------------------------------
+// RESET POLICY
+// -----------------------------------------------------------------------------
+static void TestPolicyFilters()
+{
+    BotResetPolicyConfig config;
+    config.maxLevel = 80;
+    config.ignoreGuildsWithRealPlayers = true;
+    config.Compile();
+
+    RealPlayerGuildIndex guilds;
+    guilds.LoadStoredGuilds({ { 9, 0 } });
+    LevelHistogram levels;
+
+    uint8 const eligible = BOT_ELIGIBILITY_BOT | BOT_ELIGIBILITY_RANDOM_BOT;
+    BotSnapshot bot{ 1, 0, 0, 0, 81, CLASS_WARRIOR, eligible };
+
+    BotResetDecision decision = EvaluateBotReset(bot, BotResetTrigger::Login, config, guilds, levels);
+    CHECK(decision.verdict == BotResetVerdict::Reset && decision.filter == BOT_RESET_FILTER_PASSED && decision.targetLevel == 1);
+
+    bot.flags = BOT_ELIGIBILITY_BOT;
+    CHECK(EvaluateBotReset(bot, BotResetTrigger::Login, config, guilds, levels).filter == BOT_RESET_FILTER_NOT_RANDOM_BOT);
+    bot.flags = 0;
+    CHECK(EvaluateBotReset(bot, BotResetTrigger::Login, config, guilds, levels).filter == BOT_RESET_FILTER_NOT_BOT);
+    bot.flags = eligible | BOT_ELIGIBILITY_EXCLUDED;
+    CHECK(EvaluateBotReset(bot, BotResetTrigger::Login, config, guilds, levels).filter == BOT_RESET_FILTER_EXCLUDED);
+
+    // The level rules run first, so a real player at a harmless level never reaches the eligibility bits
+    bot.flags = 0;
+    bot.level = 40;
+    CHECK(EvaluateBotReset(bot, BotResetTrigger::Login, config, guilds, levels).filter == BOT_RESET_FILTER_LEVEL);
+
+    bot.flags = eligible;
+    bot.level = 81;
+    bot.guildId = 9;
+    decision = EvaluateBotReset(bot, BotResetTrigger::Login, config, guilds, levels);
+    CHECK(decision.verdict == BotResetVerdict::None && decision.filter == BOT_RESET_FILTER_GUILD);
+
+    config.ignoreGuildsWithRealPlayers = false;
+    CHECK(EvaluateBotReset(bot, BotResetTrigger::Login, config, guilds, levels).verdict == BotResetVerdict::Reset);
+    config.ignoreGuildsWithRealPlayers = true;
+
+    // Waiting for MinTimePlayed defers for the time that is left, a guild defers for the retry interval
+    config.restrictByPlayedTime = true;
+    config.minTimePlayed = 1000;
+    config.Compile();
+    bot = BotSnapshot{ 2, 400, 400, 0, 80, CLASS_WARRIOR, eligible };
+    decision = EvaluateBotReset(bot, BotResetTrigger::Login, config, guilds, levels);
+    CHECK(decision.verdict == BotResetVerdict::Defer && decision.deferSeconds == 600);
+    bot.guildId = 9;
+    decision = EvaluateBotReset(bot, BotResetTrigger::Login, config, guilds, levels);
+    CHECK(decision.verdict == BotResetVerdict::Defer && decision.filter == BOT_RESET_FILTER_GUILD && decision.deferSeconds == config.retryInterval);
+    bot.guildId = 0;
+
+    bot.levelPlayedTime = 1000;
+    CHECK(EvaluateBotReset(bot, BotResetTrigger::TimeCheck, config, guilds, levels).verdict == BotResetVerdict::Reset);
+
+    // A failed roll defers a time-checked bot and leaves a hooked one alone
+    config.chancePercent = 0;
+    config.Compile();
+    decision = EvaluateBotReset(bot, BotResetTrigger::TimeCheck, config, guilds, levels);
+    CHECK(decision.verdict == BotResetVerdict::Defer && decision.deferSeconds == config.retryInterval);
+    config.restrictByPlayedTime = false;
+    config.Compile();
+    decision = EvaluateBotReset(bot, BotResetTrigger::Login, config, guilds, levels);
+    CHECK(decision.verdict == BotResetVerdict::None && decision.filter == BOT_RESET_FILTER_PASSED);
+
+    // Regression: a reset put off by the cooldown is time-checked once the cooldown is over. Without the
+    // time restriction that check rolls once like a hook and is not retried.
+    decision = EvaluateBotReset(bot, BotResetTrigger::TimeCheck, config, guilds, levels);
+    CHECK(decision.verdict == BotResetVerdict::None && decision.filter == BOT_RESET_FILTER_PASSED);
+    bot.guildId = 9;
+    decision = EvaluateBotReset(bot, BotResetTrigger::TimeCheck, config, guilds, levels);
+    CHECK(decision.verdict == BotResetVerdict::None && decision.filter == BOT_RESET_FILTER_GUILD);
+    bot.guildId = 0;
+    config.chancePercent = 100;
+    config.Compile();
+    decision = EvaluateBotReset(bot, BotResetTrigger::TimeCheck, config, guilds, levels);
+    CHECK(decision.verdict == BotResetVerdict::Reset && decision.targetLevel == 1);
+    bot.level = 81;
+    CHECK(EvaluateBotReset(bot, BotResetTrigger::TimeCheck, config, guilds, levels).verdict == BotResetVerdict::Reset);
+}
+
+static void TestBatchMatchesSingle()
+{
+    BotResetPolicyConfig config;
+    config.maxLevel = 80;
+    config.chancePercent = 35;
+    config.scaledChance = true;
+    config.restrictByPlayedTime = true;
+    config.ignoreGuildsWithRealPlayers = true;
+    config.skipRanges = { { 20, 25 }, { 58, 60 } };
+    config.rollSeed = 1234;
+    config.Compile();
+
+    RealPlayerGuildIndex guilds;
+    std::vector<RealPlayerGuildIndex::StoredGuild> stored;
+    for (uint32 guildId = 1; guildId <= 50; guildId += 3)
+        stored.push_back({ guildId, 0 });
+    guilds.LoadStoredGuilds(stored);
+    LevelHistogram levels;
+
+    std::vector<BotSnapshot> bots = MakeSyntheticBots(5000, 50);
+    BotSnapshotBatch batch;
+    for (BotSnapshot const& bot : bots)
+        batch.Add(bot);
+
+    std::vector<BotResetDecision> decisions;
+    for (BotResetTrigger trigger : { BotResetTrigger::Login, BotResetTrigger::LevelChanged, BotResetTrigger::TimeCheck })
+    {
+        EvaluateBotResetBatch(batch, trigger, config, guilds, levels, decisions);
+        CHECK(decisions.size() == bots.size());
+
+        uint32 mismatches = 0;
+        for (std::size_t i = 0; i < bots.size(); ++i)
+            if (!SameDecision(decisions[i], EvaluateBotReset(bots[i], trigger, config, guilds, levels)))
+                ++mismatches;
+        CHECK(mismatches == 0);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// CHANCE ROLLS
+// -----------------------------------------------------------------------------
+static void TestRolls()
+{
+    CHECK(ComputeResetRoll(1, 2, 3, BotResetTrigger::Login, 4) == ComputeResetRoll(1, 2, 3, BotResetTrigger::Login, 4));
+
+    // Uniform over 0-99 across bots and across the epochs of one bot
+    std::array<uint32, 100> acrossBots{};
+    std::array<uint32, 100> acrossEpochs{};
+    bool inRange = true;
+    for (uint32 i = 0; i < 100000; ++i)
+    {
+        uint8 roll = ComputeResetRoll(0, i + 1, 80, BotResetTrigger::Login, 3600);
+        uint8 epochRoll = ComputeResetRoll(7, 42, 80, BotResetTrigger::TimeCheck, i);
+        inRange = inRange && roll < 100 && epochRoll < 100;
+        ++acrossBots[roll % 100];
+        ++acrossEpochs[epochRoll % 100];
+    }
+    CHECK(inRange);
+    CHECK(*std::min_element(acrossBots.begin(), acrossBots.end()) > 850);
+    CHECK(*std::max_element(acrossBots.begin(), acrossBots.end()) < 1150);
+    CHECK(*std::min_element(acrossEpochs.begin(), acrossEpochs.end()) > 850);
+    CHECK(*std::max_element(acrossEpochs.begin(), acrossEpochs.end()) < 1150);
+
+    // The seed, trigger and epoch each give a bot a fresh roll
+    uint32 sameSeed = 0, sameTrigger = 0, sameEpoch = 0;
+    for (uint32 guid = 1; guid <= 10000; ++guid)
+    {
+        uint8 roll = ComputeResetRoll(0, guid, 80, BotResetTrigger::Login, 100);
+        sameSeed += roll == ComputeResetRoll(1, guid, 80, BotResetTrigger::Login, 100);
+        sameTrigger += roll == ComputeResetRoll(0, guid, 80, BotResetTrigger::TimeCheck, 100);
+        sameEpoch += roll == ComputeResetRoll(0, guid, 80, BotResetTrigger::Login, 101);
+    }
+    CHECK(sameSeed < 200);
+    CHECK(sameTrigger < 200);
+    CHECK(sameEpoch < 200);
+
+    // The configured chance is the share of bots reset
+    BotResetPolicyConfig config;
+    config.maxLevel = 80;
+    config.chancePercent = 30;
+    config.Compile();
+    RealPlayerGuildIndex guilds;
+    LevelHistogram levels;
+    uint32 resets = 0;
+    for (uint32 guid = 1; guid <= 20000; ++guid)
+    {
+        BotSnapshot bot{ guid, 3600, 3600, 0, 80, CLASS_MAGE, BOT_ELIGIBILITY_BOT | BOT_ELIGIBILITY_RANDOM_BOT };
+        resets += EvaluateBotReset(bot, BotResetTrigger::Login, config, guilds, levels).verdict == BotResetVerdict::Reset;
+    }
+    CHECK(resets > 5600 && resets < 6400);
+
+    // Regression: the level played time is 0 right after every level-up, so as the epoch it gave a bot the same
+    // level-change roll on every reset cycle. Half the bots always reset at MaxLevel and the rest never did.
+    config.chancePercent = 50;
+    config.Compile();
+    uint32 changed = 0;
+    bool allReset = true;
+    for (uint32 guid = 1; guid <= 1000; ++guid)
+    {
+        BotSnapshot first{ guid, 0, 20 * 3600, 0, 80, CLASS_MAGE, BOT_ELIGIBILITY_BOT | BOT_ELIGIBILITY_RANDOM_BOT };
+        BotSnapshot second = first;
+        second.totalPlayedTime += 18 * 3600;
+        changed += EvaluateBotReset(first, BotResetTrigger::LevelChanged, config, guilds, levels).verdict !=
+                   EvaluateBotReset(second, BotResetTrigger::LevelChanged, config, guilds, levels).verdict;
+
+        // A bot failing its roll at MaxLevel gets through on a later cycle
+        bool reset = false;
+        for (uint32 cycle = 0; cycle < 30 && !reset; ++cycle, first.totalPlayedTime += 18 * 3600)
+            reset = EvaluateBotReset(first, BotResetTrigger::LevelChanged, config, guilds, levels).verdict == BotResetVerdict::Reset;
+        allReset = allReset && reset;
+    }
+    CHECK(changed > 400 && changed < 600);
+    CHECK(allReset);
+}
+
+// -----------------------------------------------------------------------------
+// LEVEL DISTRIBUTION
+// -----------------------------------------------------------------------------
+static void TestSteeredChance()
+{
+    LevelHistogram levels;
+    for (uint32 i = 0; i < 60; ++i)
+        levels.Add(10);
+    for (uint32 i = 0; i < 40; ++i)
+        levels.Add(20);
+    CHECK(levels.Total() == 100);
+
+    LevelDistributionTarget target;
+    target.weight[10] = 1;
+    target.weight[20] = 1;
+    target.totalWeight = 2;
+
+    // Level 10 holds 60 bots where 50 are wanted, so 10 of them have to leave
+    CHECK(ComputeSteeredResetChance(levels, target, 10) == 16);
+    CHECK(ComputeSteeredResetChance(levels, target, 20) == 0);
+    CHECK(ComputeSteeredResetChance(levels, target, 30) == 0);
+
+    levels.Move(10, 20);
+    levels.Remove(10);
+    CHECK(levels.Count(10) == 58 && levels.Count(20) == 41 && levels.Total() == 99);
+
+    // Regression: with "10:1" and ScaledChance every level-up below 10 used to roll 100%, so bots could never
+    // leave levels 1-9. Levels below the first band are not steered.
+    BotResetPolicyConfig config;
+    config.maxLevel = 80;
+    config.scaledChance = true;
+    for (uint32 level = 10; level <= 80; ++level)
+        config.distribution.weight[level] = 1;
+    config.distribution.totalWeight = 71;
+    config.distribution.firstLevel = 10;
+    config.Compile();
+
+    LevelHistogram population;
+    for (uint8 level = 1; level <= 80; ++level)
+        for (uint32 i = 0; i < 10; ++i)
+            population.Add(level);
+
+    RealPlayerGuildIndex guilds;
+    uint32 lowResets = 0;
+    for (uint8 level = 2; level <= 9; ++level)
+    {
+        CHECK(ComputeSteeredResetChance(population, config.distribution, level) == 0);
+        for (uint32 guid = 1; guid <= 100; ++guid)
+        {
+            BotSnapshot bot{ guid, 0, 0, 0, level, CLASS_WARRIOR, BOT_ELIGIBILITY_BOT | BOT_ELIGIBILITY_RANDOM_BOT };
+            lowResets += EvaluateBotReset(bot, BotResetTrigger::LevelChanged, config, guilds, population).verdict == BotResetVerdict::Reset;
+        }
+    }
+    CHECK(lowResets == 0);
+
+    // Inside the bands the over-full levels are still steered
+    for (uint32 i = 0; i < 20; ++i)
+        population.Add(40);
+    CHECK(ComputeSteeredResetChance(population, config.distribution, 40) > 0);
+
+    // A level listed with weight 0 is wanted empty
+    config.distribution.weight[40] = 0;
+    config.distribution.totalWeight = 70;
+    CHECK(ComputeSteeredResetChance(population, config.distribution, 40) == 100);
+
+    // Without ScaledChance the level-ups inside the bands are steered too, not only MaxLevel
+    config.scaledChance = false;
+    config.distribution.weight[40] = 1;
+    config.distribution.totalWeight = 71;
+    config.Compile();
+    CHECK(GetRule(config, 9, CLASS_WARRIOR, BotResetTrigger::LevelChanged) == BotResetPolicy::LEVEL_RULE_NONE);
+    CHECK(GetRule(config, 10, CLASS_WARRIOR, BotResetTrigger::LevelChanged) == BotResetPolicy::LEVEL_RULE_ROLL);
+    CHECK(GetRule(config, 40, CLASS_WARRIOR, BotResetTrigger::LevelChanged) == BotResetPolicy::LEVEL_RULE_ROLL);
+    CHECK(GetRule(config, 40, CLASS_WARRIOR, BotResetTrigger::Login) == BotResetPolicy::LEVEL_RULE_NONE);
+
+    uint32 midResets = 0;
+    for (uint32 guid = 1; guid <= 100; ++guid)
+    {
+        BotSnapshot bot{ guid, 0, 0, 0, 40, CLASS_WARRIOR, BOT_ELIGIBILITY_BOT | BOT_ELIGIBILITY_RANDOM_BOT };
+        midResets += EvaluateBotReset(bot, BotResetTrigger::LevelChanged, config, guilds, population).verdict == BotResetVerdict::Reset;
+    }
+    CHECK(midResets > 0);
+}
+
+// -----------------------------------------------------------------------------
+// RANDOM BOT ROSTER
+// -----------------------------------------------------------------------------
+static void TestRoster()
+{
+    RandomBotRoster roster;
+    CHECK(!roster.IsLoaded());
+
+    // Records written by the hooks before the load are newer and win
+    roster.Upsert(50).level = 7;
+    roster.Upsert(10).level = 3;
+    std::vector<RandomBotRecord> rows;
+    for (uint32 guid = 5; guid <= 60; guid += 5)
+        rows.push_back(RandomBotRecord{ guid, 1, 0, 0, 0, 1, CLASS_WARRIOR, false });
+    roster.LoadRecords(rows);
+    CHECK(roster.Size() == 12);
+    CHECK(roster.Find(50)->level == 7);
+    CHECK(roster.Find(10)->level == 3);
+    CHECK(roster.Find(15)->level == 1);
+
+    bool sorted = true;
+    for (std::size_t i = 1; i < roster.Records().size(); ++i)
+        sorted = sorted && roster.Records()[i - 1].guid < roster.Records()[i].guid;
+    CHECK(sorted);
+
+    rows.clear();
+    for (uint32 guid = 61; guid <= 63; ++guid)
+        rows.push_back(RandomBotRecord{ guid, 1, 9, 0, 0, 1, CLASS_WARRIOR, false });
+    roster.LoadRecords(rows);
+    roster.SetLoaded();
+    CHECK(roster.IsLoaded());
+    CHECK(roster.Size() == 15);
+
+    roster.ClearGuild(9);
+    CHECK(roster.Find(62)->guildId == 0);
+    roster.Remove(62);
+    CHECK(!roster.Find(62));
+    CHECK(roster.Size() == 14);
+}
+
+// -----------------------------------------------------------------------------
+// RESET KIT CACHE
+// -----------------------------------------------------------------------------
+static void TestResetKits()
+{
+    BotResetKitCache kits;
+    BotResetKit kit;
+    kit.items[0] = 100;
+    kit.spells = { 30, 10, 20 };
+    kits.Add(1, CLASS_WARRIOR, 0, 10, kit);
+    CHECK(kits.Size() == 0 && !kits.HasKits(1, CLASS_WARRIOR, 10));
+
+    // A combination is only used once all its variants are built
+    kits.SetVariants(2);
+    kits.Add(1, CLASS_WARRIOR, 0, 10, kit);
+    CHECK(!kits.HasKits(1, CLASS_WARRIOR, 10) && kits.Find(1, CLASS_WARRIOR, 0, 10, 1) == nullptr);
+    kit.items[0] = 200;
+    kits.Add(1, CLASS_WARRIOR, 0, 10, kit);
+    kits.Add(1, CLASS_WARRIOR, 0, 10, kit);
+    CHECK(kits.Size() == 2);
+    CHECK(kits.HasKits(1, CLASS_WARRIOR, 10));
+    CHECK(!kits.HasKits(2, CLASS_WARRIOR, 10) && !kits.HasKits(1, CLASS_PALADIN, 10) && !kits.HasKits(1, CLASS_WARRIOR, 11));
+    CHECK(kits.Find(1, CLASS_WARRIOR, 1, 10, 1) == nullptr);
+
+    BotResetKit const* found = kits.Find(1, CLASS_WARRIOR, 0, 10, 1);
+    CHECK(found && found->spells == std::vector<uint32>({ 10, 20, 30 }));
+
+    // Bots are spread over the variants by GUID
+    bool seen[2] = { false, false };
+    for (uint32 guid = 1; guid <= 100; ++guid)
+    {
+        BotResetKit const* variant = kits.Find(1, CLASS_WARRIOR, 0, 10, guid);
+        CHECK(variant == kits.Find(1, CLASS_WARRIOR, 0, 10, guid));
+        seen[variant->items[0] == 200] = true;
+    }
+    CHECK(seen[0] && seen[1]);
+
+    // New settings drop the kits built under the old ones
+    kits.SetVariants(2);
+    CHECK(kits.Size() == 0 && !kits.HasKits(1, CLASS_WARRIOR, 10));
+}
+
+// -----------------------------------------------------------------------------
+// LATENCY HISTOGRAM
+// -----------------------------------------------------------------------------
+static void TestLatencyHistogram()
+{
+    LatencyHistogram histogram;
+    CHECK(histogram.Percentile(50) == 0);
+    CHECK(histogram.Average() == 0);
+
+    for (uint64 sample : { 1, 2, 3, 1000 })
+        histogram.Record(sample);
+    CHECK(histogram.Count() == 4);
+    CHECK(histogram.Max() == 1000);
+    CHECK(histogram.Average() == 251);
+    CHECK(histogram.Percentile(50) == 4);
+    CHECK(histogram.Percentile(99) == 1024);
+
+    // Samples above the last bucket report the maximum
+    histogram.Record(uint64(1) << 40);
+    CHECK(histogram.Percentile(100) == uint64(1) << 40);
+
+    histogram.Reset();
+    CHECK(histogram.Count() == 0);
+    CHECK(histogram.Max() == 0);
+}
+
+// -----------------------------------------------------------------------------
+// ADAPTIVE WORK THROTTLE
+// -----------------------------------------------------------------------------
+static void TestWorkThrottle()
+{
+    AdaptiveWorkThrottle throttle;
+
+    // Disabled, every update gets a turn at the configured work
+    for (uint32 i = 0; i < 100; ++i)
+    {
+        throttle.Update(500, 0);
+        CHECK(throttle.HasTurn());
+    }
+    CHECK(throttle.GetScale() == AdaptiveWorkThrottle::SCALE_NORMAL);
+    CHECK(throttle.ScaleLimit(10) == 10);
+
+    // A slow server backs off
+    uint32 turns = 0;
+    for (uint32 i = 0; i < 100; ++i)
+    {
+        throttle.Update(500, 100);
+        turns += throttle.HasTurn();
+    }
+    CHECK(throttle.GetScale() < AdaptiveWorkThrottle::SCALE_NORMAL);
+    CHECK(turns < 100);
+
+    // One that keeps lagging still gets a turn at the floor, so the queue never stops draining
+    turns = 0;
+    for (uint32 i = 0; i < 1000; ++i)
+    {
+        throttle.Update(500, 100);
+        turns += throttle.HasTurn();
+    }
+    CHECK(throttle.GetScale() == AdaptiveWorkThrottle::SCALE_MIN);
+    CHECK(turns >= 1000 * AdaptiveWorkThrottle::SCALE_MIN / AdaptiveWorkThrottle::SCALE_NORMAL - 1);
+
+    // A fast one catches up with raised limits
+    for (uint32 i = 0; i < 200; ++i)
+        throttle.Update(10, 100);
+    CHECK(throttle.GetScale() == AdaptiveWorkThrottle::SCALE_MAX);
+    CHECK(throttle.HasTurn());
+    CHECK(throttle.ScaleLimit(10) == 20);
+    CHECK(throttle.ScaleLimit(0) == 0);
+}
+
+// -----------------------------------------------------------------------------
+// DEBUG LOG BUFFERING
+// -----------------------------------------------------------------------------
+static void TestDebugLogBuffering()
+{
+    BoundedRing<uint32> ring(3);
+    CHECK(ring.Push(1) && ring.Push(2) && ring.Push(3));
+    CHECK(!ring.Push(4));
+
+    std::vector<uint32> out;
+    ring.PopAll(out);
+    CHECK((out == std::vector<uint32>{ 1, 2, 3 }));
+    CHECK(ring.Empty());
+
+    // Wraps around
+    CHECK(ring.Push(5) && ring.Push(6));
+    out.clear();
+    ring.PopAll(out);
+    CHECK((out == std::vector<uint32>{ 5, 6 }));
+
+    LogRateLimiter limiter(2);
+    CHECK(limiter.Allow(0, 0, 2));
+    CHECK(limiter.Allow(0, 10, 2));
+    CHECK(!limiter.Allow(0, 20, 2));
+    CHECK(limiter.Allow(1, 20, 2));
+    CHECK(limiter.TakeSuppressed(0) == 1);
+    CHECK(limiter.TakeSuppressed(0) == 0);
+    CHECK(limiter.Allow(0, 1000, 2));
+    for (uint32 i = 0; i < 100; ++i)
+        CHECK(limiter.Allow(1, 2000, 0));
+}
+
+int main()
+{
+    TestExclusions();
+    TestGuildIndex();
+    TestDeadlines();
+    TestResetChance();
+    TestPolicyTable();
+    TestPolicyFilters();
+    TestBatchMatchesSingle();
+    TestRolls();
+    TestSteeredChance();
+    TestRoster();
+    TestResetKits();
+    TestLatencyHistogram();
+    TestWorkThrottle();
+    TestDebugLogBuffering();
+
+    std::printf("%u checks, %u failures\n", g_Checks, g_Failures);
+    return g_Failures ? 1 : 0;
+}
@@ -0,0 +1,12 @@
+// Stand-in for the AzerothCore DBCEnums.h
+#ifndef MOD_PLAYER_BOT_RESET_TESTS_DBC_ENUMS_H
+#define MOD_PLAYER_BOT_RESET_TESTS_DBC_ENUMS_H
+
+enum LevelLimit
+{
+    DEFAULT_MAX_LEVEL = 80,
+    MAX_LEVEL         = 100,
+    STRONG_MAX_LEVEL  = 255
+};
+
+#endif // MOD_PLAYER_BOT_RESET_TESTS_DBC_ENUMS_H
@@ -0,0 +1,16 @@
+// Stand-in for the AzerothCore Define.h, only the fixed width integer names are needed by the core header
+#ifndef MOD_PLAYER_BOT_RESET_TESTS_DEFINE_H
+#define MOD_PLAYER_BOT_RESET_TESTS_DEFINE_H
+
+#include <cstdint>
+
+typedef std::int64_t int64;
+typedef std::int32_t int32;
+typedef std::int16_t int16;
+typedef std::int8_t int8;
+typedef std::uint64_t uint64;
+typedef std::uint32_t uint32;
+typedef std::uint16_t uint16;
+typedef std::uint8_t uint8;
+
+#endif // MOD_PLAYER_BOT_RESET_TESTS_DEFINE_H
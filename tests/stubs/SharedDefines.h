@@ -0,0 +1,24 @@
+// Stand-in for the AzerothCore SharedDefines.h, class IDs as in the 3.3.5 client
+#ifndef MOD_PLAYER_BOT_RESET_TESTS_SHARED_DEFINES_H
+#define MOD_PLAYER_BOT_RESET_TESTS_SHARED_DEFINES_H
+
+#include "Define.h"
+
+enum Classes
+{
+    CLASS_NONE         = 0,
+    CLASS_WARRIOR      = 1,
+    CLASS_PALADIN      = 2,
+    CLASS_HUNTER       = 3,
+    CLASS_ROGUE        = 4,
+    CLASS_PRIEST       = 5,
+    CLASS_DEATH_KNIGHT = 6,
+    CLASS_SHAMAN       = 7,
+    CLASS_MAGE         = 8,
+    CLASS_WARLOCK      = 9,
+    CLASS_DRUID        = 11
+};
+
+#define MAX_CLASSES 12
+
+#endif // MOD_PLAYER_BOT_RESET_TESTS_SHARED_DEFINES_H
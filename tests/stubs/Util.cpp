@@ -0,0 +1,40 @@
+#include "Util.h"
+#include <cwctype>
+
+// Decodes up to 4 byte sequences and rejects malformed input, like the core does
+bool Utf8toWStr(std::string_view utf8str, std::wstring& wstr)
+{
+    wstr.clear();
+    for (std::size_t i = 0; i < utf8str.size();)
+    {
+        unsigned char lead = static_cast<unsigned char>(utf8str[i]);
+        std::size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x06 ? 2 : (lead >> 4) == 0x0E ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+        if (length == 0 || i + length > utf8str.size())
+        {
+            wstr.clear();
+            return false;
+        }
+
+        char32_t codepoint = length == 1 ? lead : lead & (0xFF >> (length + 1));
+        for (std::size_t j = 1; j < length; ++j)
+        {
+            unsigned char next = static_cast<unsigned char>(utf8str[i + j]);
+            if ((next >> 6) != 0x02)
+            {
+                wstr.clear();
+                return false;
+            }
+            codepoint = (codepoint << 6) | (next & 0x3F);
+        }
+
+        wstr.push_back(static_cast<wchar_t>(codepoint));
+        i += length;
+    }
+    return true;
+}
+
+void wstrToLower(std::wstring& str)
+{
+    for (wchar_t& c : str)
+        c = static_cast<wchar_t>(std::towlower(static_cast<std::wint_t>(c)));
+}
@@ -0,0 +1,11 @@
+// Stand-in for the AzerothCore Util.h, the name folding used by the exclusion matcher
+#ifndef MOD_PLAYER_BOT_RESET_TESTS_UTIL_H
+#define MOD_PLAYER_BOT_RESET_TESTS_UTIL_H
+
+#include <string>
+#include <string_view>
+
+bool Utf8toWStr(std::string_view utf8str, std::wstring& wstr);
+void wstrToLower(std::wstring& str);
+
+#endif // MOD_PLAYER_BOT_RESET_TESTS_UTIL_H
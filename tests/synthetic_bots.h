@@ -0,0 +1,58 @@
+#ifndef MOD_PLAYER_BOT_RESET_TESTS_SYNTHETIC_BOTS_H
+#define MOD_PLAYER_BOT_RESET_TESTS_SYNTHETIC_BOTS_H
+
+// Deterministic synthetic bot populations for the core tests and benchmarks
+
+#include "mod-player-bot-reset-core.h"
+#include <vector>
+
+class SyntheticRandom
+{
+public:
+    explicit SyntheticRandom(uint64 seed) : _state(seed) { }
+
+    uint32 Next()
+    {
+        // xorshift64*
+        _state ^= _state >> 12;
+        _state ^= _state << 25;
+        _state ^= _state >> 27;
+        return static_cast<uint32>((_state * 0x2545F4914F6CDD1Dull) >> 32);
+    }
+
+    uint32 Below(uint32 bound) { return static_cast<uint32>((uint64(Next()) * bound) >> 32); }
+
+private:
+    uint64 _state;
+};
+
+// Mostly eligible random bots spread over levels 1-85, a few excluded, real or non-random ones, one in
+// five in one of guildCount guilds
+inline std::vector<BotSnapshot> MakeSyntheticBots(std::size_t count, uint32 guildCount, uint64 seed = 1)
+{
+    static uint8 const classes[] = { CLASS_WARRIOR, CLASS_PALADIN, CLASS_HUNTER, CLASS_ROGUE, CLASS_PRIEST,
+                                     CLASS_DEATH_KNIGHT, CLASS_SHAMAN, CLASS_MAGE, CLASS_WARLOCK, CLASS_DRUID };
+
+    SyntheticRandom random(seed);
+    std::vector<BotSnapshot> bots;
+    bots.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        BotSnapshot bot{};
+        bot.guid = static_cast<uint32>(i + 1);
+        bot.playerClass = classes[random.Below(sizeof(classes))];
+        bot.level = static_cast<uint8>(std::max<uint32>(1 + random.Below(85), GetClassStartLevel(bot.playerClass)));
+        bot.levelPlayedTime = random.Below(2 * 86400);
+        bot.totalPlayedTime = bot.levelPlayedTime + random.Below(30 * 86400);
+        bot.guildId = guildCount && random.Below(5) == 0 ? 1 + random.Below(guildCount) : 0;
+
+        uint32 kind = random.Below(100);
+        bot.flags = kind < 2 ? 0 : kind < 4 ? BOT_ELIGIBILITY_BOT : BOT_ELIGIBILITY_BOT | BOT_ELIGIBILITY_RANDOM_BOT;
+        if (kind >= 4 && kind < 6)
+            bot.flags |= BOT_ELIGIBILITY_EXCLUDED;
+        bots.push_back(bot);
+    }
+    return bots;
+}
+
+#endif // MOD_PLAYER_BOT_RESET_TESTS_SYNTHETIC_BOTS_H